@@ -4,7 +4,7 @@
  * Created:
  *   10/12/2020, 17:24:35
  * Last edited:
- *   11/02/2021, 17:35:58
+ *   18/10/2026, 18:02:03
  * Auto updated?
  *   Yes
  *
@@ -16,37 +16,100 @@
 **/
 
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 
 #include "ADLParser.hpp"
 
-#include "BuildSymbolTable.hpp"
-#include "CheckReferences.hpp"
+#include "SemanticAnalysis.hpp"
+#include "BuildDependencyGraph.hpp"
+#include "FoldPatterns.hpp"
 
 using namespace std;
 using namespace ArgumentParser;
 
 
+/* Prints the diagnostics logged since the last call to stderr, sorted by location, and returns whether any errors have been logged so far. The structured formats are written as one document by finish() instead. */
+static bool report() {
+    if (Exceptions::error_handler.output_format == Exceptions::DiagnosticsFormat::text) { Exceptions::error_handler.flush(cerr); }
+    return Exceptions::error_handler.errors() > 0;
+}
+
+/* Prints whatever diagnostics haven't been printed yet to stderr and returns the given exit code. */
+static int finish(int code) {
+    Exceptions::error_handler.flush(cerr);
+    return code;
+}
+
+
+/* Reads the number after the given prefix in the given argument into the given limit. Returns false if the argument doesn't start with the prefix or has no valid number after it. */
+static bool read_limit(const char* arg, const char* prefix, size_t& limit) {
+    size_t prefix_len = strlen(prefix);
+    if (strncmp(arg, prefix, prefix_len) != 0) { return false; }
+    char* end;
+    unsigned long value = strtoul(arg + prefix_len, &end, 10);
+    if (end == arg + prefix_len || *end != '\0') { return false; }
+    limit = (size_t) value;
+    return true;
+}
+
+
 /* Entry point for the compiler */
 int main(int argc, char** argv) {
+    // Read the options, of which the file to compile is the last argument
+    bool dump_deps = false;
+    Exceptions::error_handler.max_errors = 100;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--dump-deps") == 0) { dump_deps = true; }
+        else if (strcmp(argv[i], "--diagnostics-format=text") == 0) { Exceptions::error_handler.output_format = Exceptions::DiagnosticsFormat::text; }
+        else if (strcmp(argv[i], "--diagnostics-format=json") == 0) { Exceptions::error_handler.output_format = Exceptions::DiagnosticsFormat::json; }
+        else if (strcmp(argv[i], "--diagnostics-format=sarif") == 0) { Exceptions::error_handler.output_format = Exceptions::DiagnosticsFormat::sarif; }
+        else if (read_limit(argv[i], "--max-errors=", Exceptions::error_handler.max_errors)) {}
+        else if (read_limit(argv[i], "--max-warnings=", Exceptions::error_handler.max_warnings)) {}
+        else { argc = 0; }
+    }
     if (argc < 2) {
-        cout << "Usage: " << argv[0] << " <file_to_compile>" << endl;
+        cout << "Usage: " << argv[0] << " [--dump-deps] [--diagnostics-format=text|json|sarif] [--max-errors=N] [--max-warnings=N] <file_to_compile>" << endl;
+        cout << "A limit of 0 means no limit; by default, at most 100 errors and any number of warnings are shown." << endl;
         return EXIT_SUCCESS;
     }
 
+    // Collect the diagnostics of each step, so they can be printed sorted and in one go
+    Exceptions::error_handler.print_on_add = false;
+
     // Simply call the parser
-    ADLTree* tree = Parser::parse(argv[1]);
+    ADLTree* tree;
+    try {
+        tree = Parser::parse(argv[argc - 1]);
+    } catch (Exceptions::ExceptionHandler& e) {
+        return finish(EXIT_FAILURE);
+    }
     
     // Stop if exceptions have been thrown
-    if (Exceptions::error_handler.errors() > 0) {
-        return EXIT_FAILURE;
+    if (report()) {
+        return finish(EXIT_FAILURE);
+    }
+
+    // Warnings about the tree are suppressed where its @suppress modifiers say so
+    Exceptions::SuppressionList::Scope suppression_scope(tree->suppressions.get());
+
+    // Next, build the symbol table and check the references in one go
+    traversal_semantic_analysis(tree);
+    if (report()) {
+        return finish(EXIT_FAILURE);
     }
 
-    // Next, start with the first traversal
-    tree->symbol_table = traversal_build_symbol_table(tree);
-    if (Exceptions::error_handler.errors() > 0) {
-        return EXIT_FAILURE;
+    // Find out which definitions and properties depend on which, which also makes sure no property depends on itself. The graph is dumped even if it has cycles, since that's when it helps the most
+    DependencyGraph dependencies = traversal_build_dependency_graph(tree);
+    if (dump_deps) { dependencies.print(cout); }
+    if (report()) {
+        return finish(EXIT_FAILURE);
     }
 
+    // With the order known, fold the patterns that are built from other patterns into one
+    traversal_fold_patterns(tree, dependencies);
+    report();
+
     #ifdef DEBUG
     // Print the table
     std::cout << std::endl << "Symbol table:" << std::endl;
@@ -55,12 +118,6 @@ int main(int argc, char** argv) {
     std::cout << "--------------------------------------" << std::endl << std::endl;
     #endif
 
-    // Move to the second traversal; this one checks the references
-    traversal_check_references(tree);
-    if (Exceptions::error_handler.errors() > 0) {
-        return EXIT_FAILURE;
-    }
-
     // Alright, it's parsed!
-    return EXIT_SUCCESS;
+    return finish(EXIT_SUCCESS);
 }
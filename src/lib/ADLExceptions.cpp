@@ -4,16 +4,29 @@
  * Created:
  *   14/11/2020, 18:05:10
  * Last edited:
- *   05/01/2021, 14:23:36
+ *   18/10/2026, 20:16:26
  * Auto updated?
  *   Yes
  *
  * Description:
  *   This file contains the root of the ArgumentParser exception system,
  *   and the functionality to print each exception in a very pretty,
- *   GCC-like style.
+ *   GCC-like style. Logged exceptions are kept as compact records, whose
+ *   messages are only formatted once they are printed. Printing renders
+ *   them into a single buffer first, sorted by location and without
+ *   duplicates, and only uses colours if stderr is a terminal. They can
+ *   also be written as JSON or SARIF for other tools to consume. Each
+ *   thread logs to the handler made active on it, so compilations on
+ *   separate threads never share one.
 **/
 
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <unistd.h>
+
+#include "SourceManager.hpp"
+#include "SuppressionList.hpp"
 #include "ADLExceptions.hpp"
 
 using namespace std;
@@ -21,238 +34,454 @@ using namespace ArgumentParser;
 using namespace ArgumentParser::Exceptions;
 
 
-/***** ADLERROR CLASS *****/
-
-/* Function that prints the error to the given output stream. */
-std::ostream& ADLError::print(std::ostream& os) const {
-    // Always print the possible list of breadcrumbs first
-    for (size_t i = 0; i < this->filenames.size() - 1; i++) {
-        os << "\033[1m" << this->filenames[i] << ":\033[0m" << endl << "--> ";
+/***** HELPER STRUCTS *****/
+/* A diagnostic together with the notes accompanying it, as the range [first, last) in a handler, and the key by which it is sorted. */
+struct DiagnosticGroup {
+    /* The index of the diagnostic itself. */
+    size_t first;
+    /* One past the index of its last note. */
+    size_t last;
+    /* The place of the diagnostic's file among all files with diagnostics in the range, which are ordered by their include path. */
+    uint32_t file;
+    /* One past the byte offset of the diagnostic in its file, or 0 if it isn't tied to a position. */
+    uint64_t offset;
+};
+
+/* Orders groups of diagnostics by their (file, offset) key. */
+struct GroupOrder {
+    /* Returns whether the first group should come before the second one. */
+    inline bool operator()(const DiagnosticGroup& g1, const DiagnosticGroup& g2) const {
+        return g1.file < g2.file || (g1.file == g2.file && g1.offset < g2.offset);
     }
+};
 
-    // Then, we can also always print the filename itself
-    os << "\033[1m" << this->filenames[this->filenames.size() - 1] << ":";
-    
-    // Continue with the error & the message
-    os << " \033[31merror: \033[0m" << this->message << endl;
-
-    // Done
-    return os;
-}
 
 
 
 
 
-/***** ADLCOMPILEERROR CLASS *****/
+/***** HELPER FUNCTIONS *****/
+/* Returns whether the two given diagnostics (from the given handler) say the same thing at the same place. */
+static bool same_diagnostic(const ExceptionHandler& handler, const Diagnostic& diag1, const Diagnostic& diag2) {
+    if (diag1.kind != diag2.kind || diag1.type != diag2.type || diag1.n_args != diag2.n_args) { return false; }
+    const Location& l1 = diag1.location;
+    const Location& l2 = diag2.location;
+    if (l1.line1 != l2.line1 || l1.col1 != l2.col1 || l1.line2 != l2.line2 || l1.col2 != l2.col2 || l1.trail != l2.trail) { return false; }
+    return handler.message(diag1) == handler.message(diag2);
+}
 
-/* Function that prints the compilation error to the given output stream. */
-std::ostream& ADLCompileError::print(std::ostream& os) const {
-    const DebugInfo& debug = this->debug;
+/* Returns whether the two given groups of diagnostics (from the given handler) are duplicates of each other. */
+static bool same_group(const ExceptionHandler& handler, const DiagnosticGroup& g1, const DiagnosticGroup& g2) {
+    if (g1.last - g1.first != g2.last - g2.first || g1.file != g2.file || g1.offset != g2.offset) { return false; }
+    for (size_t i = 0; i < g1.last - g1.first; i++) {
+        if (!same_diagnostic(handler, handler[g1.first + i], handler[g2.first + i])) { return false; }
+    }
+    return true;
+}
 
-    // Always print the possible list of breadcrumbs first
-    for (size_t i = 0; i < this->filenames.size() - 1; i++) {
-        os << "\033[1m" << this->filenames[i] << ":\033[0m" << endl << "--> ";
+/* Groups each diagnostic in the range [first, last) of the given handler with the notes that follow it, and returns the groups sorted by (file, offset) and without duplicates. Groups with the same key keep the order in which they were logged, so the result only depends on that order and never on how long it took to compute. */
+static std::vector<DiagnosticGroup> sorted_groups(const ExceptionHandler& handler, size_t first, size_t last) {
+    // Group each diagnostic with the notes that follow it
+    std::vector<DiagnosticGroup> groups;
+    for (size_t i = first; i < last; i++) {
+        if (handler[i].kind == DiagnosticKind::note && !groups.empty()) { groups.back().last = i + 1; }
+        else { groups.push_back({ i, i + 1, 0, 0 }); }
     }
 
-    // Then, we can also always print the filename itself
-    os << "\033[1m" << this->filenames[this->filenames.size() - 1] << ":" << debug.line1 << ":" << debug.col1  << ":" << " \033[31merror: \033[0m" << this->message << endl;
+    // Number the files by their include path, so the order doesn't depend on which file happened to be read first
+    std::map<std::vector<std::string>, trail_t> trails;
+    for (size_t i = 0; i < groups.size(); i++) {
+        const Location& location = handler[groups[i].first].location;
+        trails.insert({ location.filenames(), location.trail });
+    }
+    std::unordered_map<trail_t, uint32_t> files;
+    uint32_t order = 0;
+    for (const std::pair<const std::vector<std::string>, trail_t>& trail : trails) {
+        files.insert({ trail.second, order++ });
+    }
 
-    // Print the line number + spacing
-    std::string strline = std::to_string(debug.line1);
-    for (size_t i = strline.size(); i < 5; i++) { os << ' '; }
-    os << strline;
-    os << " | ";
-
-    // Print the raw_line, with the correct characters in red
-    const std::string& sraw = debug.raw_line.snippet;
-    size_t line_i = debug.line1;
-    bool red_mode = false;
-    for (size_t i = 0; i < sraw.size(); i++) {
-        // If we're at the correct pos in the string, write the red-marker
-        if (line_i == debug.line1 && i + 1 == debug.col1) {
-            os << "\033[31;1m";
-            red_mode = true;
+    // Key each group by the file and the byte offset its main diagnostic was logged with, using the line & column number for files whose contents weren't known then
+    uint32_t key_order = 0;
+    trail_t key_trail = 0;
+    for (size_t i = 0; i < groups.size(); i++) {
+        const Location& location = handler[groups[i].first].location;
+        if (i == 0 || key_trail != location.trail) {
+            key_order = files.at(location.trail);
+            key_trail = location.trail;
         }
+        groups[i].file = key_order;
+        if (location.line1 == 0 || location.offset > 0) { groups[i].offset = location.offset; }
+        else { groups[i].offset = ((uint64_t) location.line1 << 32) | (uint64_t) location.col1; }
+    }
 
-        // Write the character, possibly doing neat newline padding
-        os << sraw[i];
-        if (i < sraw.size() - 1 && sraw[i] == '\n') {
-            if (red_mode) { os << "\033[0m"; }
-            os << "      | ";
-            if (red_mode) { os << "\033[31;1m"; }
-        }
+    // Sort the groups by their key, keeping those with the same key in the order they were logged
+    std::stable_sort(groups.begin(), groups.end(), GroupOrder());
 
-        // If we're at the correct pos in the string, go back to white text
-        if (line_i == debug.line2 && i + 1 == debug.col2) {
-            os << "\033[0m";
-            red_mode = false;
-        }
+    // Leave out the groups that are the same as the one before them
+    std::vector<DiagnosticGroup> result;
+    result.reserve(groups.size());
+    for (size_t i = 0; i < groups.size(); i++) {
+        if (!result.empty() && same_group(handler, result.back(), groups[i])) { continue; }
+        result.push_back(groups[i]);
     }
-    // Add a newline if the last character wasn't
-    if (sraw[sraw.size() - 1] != '\n') { os << '\n'; }
+    return result;
+}
 
-    // Next, write the same but with spaces and wiggly bits
-    os << "      | ";
-    for (size_t i = 1; i < debug.col1; i++) { os << ' '; }
-    // Write enough '^'s
-    os << "\033[31;1m";
-    for (size_t i = 0; i < debug.col2 - debug.col1 + 1; i++) { os << '^'; }
-    os << "\033[0m" << endl;
+/* Appends the escape sequence for the given style to the given buffer, but only if colour is enabled. */
+static inline void style(std::string& buffer, bool colour, const char* code) {
+    if (!colour) { return; }
+    buffer += "\033[";
+    buffer += code;
+    buffer += 'm';
+}
 
-    // Done
-    return os;
+/* Renders the note that the given number of repeats were folded into the diagnostic at the given location to the end of the given buffer. */
+static void render_repeats(std::string& buffer, const Location& location, uint32_t repeats, bool colour) {
+    style(buffer, colour, "1");
+    buffer += location.path();
+    buffer += ':';
+    style(buffer, colour, "0");
+    buffer += ' ';
+    style(buffer, colour, "36");
+    buffer += "note: ";
+    style(buffer, colour, "0");
+    buffer += std::to_string(repeats);
+    buffer += repeats == 1 ? " more like this follows it\n" : " more like this follow it\n";
 }
 
+/* Returns the length of the valid UTF-8 sequence that starts at the given position in the given string, or 0 if there is none. */
+static size_t utf8_length(const std::string& str, size_t i) {
+    unsigned char c = (unsigned char) str[i];
+    size_t length = c >= 0xF0 && c <= 0xF4 ? 4 : c >= 0xE0 ? 3 : c >= 0xC2 && c <= 0xDF ? 2 : 0;
+    if (length == 0 || i + length > str.size()) { return 0; }
+    for (size_t j = 1; j < length; j++) {
+        if (((unsigned char) str[i + j] & 0xC0) != 0x80) { return 0; }
+    }
+    return length;
+}
 
+/* Appends the given string to the given buffer as a quoted JSON string. Bytes that aren't valid UTF-8 (e.g., from a binary file) are replaced by U+FFFD. */
+static void append_json_string(std::string& buffer, const std::string& str) {
+    static const char* hex = "0123456789abcdef";
+    buffer += '"';
+    for (size_t i = 0; i < str.size(); i++) {
+        unsigned char c = (unsigned char) str[i];
+        if (c >= 0x80) {
+            size_t length = utf8_length(str, i);
+            if (length == 0) { buffer += "\\ufffd"; }
+            else { buffer.append(str, i, length); i += length - 1; }
+            continue;
+        }
+        switch (c) {
+            case '"': buffer += "\\\""; break;
+            case '\\': buffer += "\\\\"; break;
+            case '\n': buffer += "\\n"; break;
+            case '\r': buffer += "\\r"; break;
+            case '\t': buffer += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    buffer += "\\u00";
+                    buffer += hex[c >> 4];
+                    buffer += hex[c & 0xF];
+                } else {
+                    buffer += (char) c;
+                }
+                break;
+        }
+    }
+    buffer += '"';
+}
 
+/* Returns the name of the given kind of diagnostic as used in the structured formats. */
+static const char* kind_name(DiagnosticKind kind) {
+    switch (kind) {
+        case DiagnosticKind::error: return "error";
+        case DiagnosticKind::compile_error: return "compile_error";
+        case DiagnosticKind::warning: return "warning";
+        case DiagnosticKind::compile_warning: return "compile_warning";
+        default: return "note";
+    }
+}
 
+/* Returns the name of the given severity as used in the structured formats (which matches SARIF's levels). */
+static const char* severity_name(Severity severity) {
+    switch (severity) {
+        case Severity::error: return "error";
+        case Severity::warning: return "warning";
+        default: return "note";
+    }
+}
 
-/***** ADLWARNING CLASS *****/
+/* Returns whether diagnostics of the given kind point to a position within their file. */
+static inline bool has_position(DiagnosticKind kind) {
+    return kind == DiagnosticKind::compile_error || kind == DiagnosticKind::compile_warning || kind == DiagnosticKind::note;
+}
 
-/* Function that prints the warning to the given output stream. */
-std::ostream& ADLWarning::print(std::ostream& os) const {
-    // Always print the possible list of breadcrumbs first
-    for (size_t i = 0; i < this->filenames.size() - 1; i++) {
-        os << "\033[1m" << this->filenames[i] << ":\033[0m" << endl << "--> ";
+/* Appends the given diagnostic (from the given handler) to the given buffer as a JSON object, without its notes and without closing the object. */
+static void append_json_diagnostic(std::string& buffer, const ExceptionHandler& handler, const Diagnostic& diagnostic) {
+    const Location& location = diagnostic.location;
+    const std::vector<std::string>& filenames = location.filenames();
+
+    // The kind of diagnostic and its message
+    buffer += "{\"kind\":\"";
+    buffer += kind_name(diagnostic.kind);
+    buffer += "\",\"severity\":\"";
+    buffer += severity_name(severity_of(diagnostic.kind));
+    buffer += '"';
+    if (severity_of(diagnostic.kind) == Severity::warning) {
+        buffer += ",\"type\":";
+        append_json_string(buffer, warningtype_names.at(diagnostic.type));
     }
+    buffer += ",\"message\":";
+    append_json_string(buffer, handler.message(diagnostic));
+
+    // Where it happened, including the files that included that file
+    buffer += ",\"file\":";
+    append_json_string(buffer, filenames[filenames.size() - 1]);
+    buffer += ",\"included_from\":[";
+    for (size_t i = 0; i + 1 < filenames.size(); i++) {
+        if (i > 0) { buffer += ','; }
+        append_json_string(buffer, filenames[i]);
+    }
+    buffer += ']';
+    if (has_position(diagnostic.kind)) {
+        buffer += ",\"line\":" + std::to_string(location.line1);
+        buffer += ",\"column\":" + std::to_string(location.col1);
+        buffer += ",\"end_line\":" + std::to_string(location.line2);
+        buffer += ",\"end_column\":" + std::to_string(location.col2);
+    }
+}
 
-    // Then, we can also always print the filename itself
-    os << "\033[1m" << this->filenames[this->filenames.size() - 1] << ":" << " \033[35mwarning: \033[0m" << this->message << " [\033[35;1m" << warningtype_names.at(this->type) << "\033[0m]" << endl;
-
-    // Done
-    return os;
+/* Appends a SARIF physicalLocation object for the given diagnostic to the given buffer. */
+static void append_sarif_location(std::string& buffer, const Diagnostic& diagnostic) {
+    const Location& location = diagnostic.location;
+    buffer += "\"physicalLocation\":{\"artifactLocation\":{\"uri\":";
+    append_json_string(buffer, location.path());
+    buffer += '}';
+    if (has_position(diagnostic.kind)) {
+        // SARIF's end column points just past the region
+        buffer += ",\"region\":{\"startLine\":" + std::to_string(location.line1);
+        buffer += ",\"startColumn\":" + std::to_string(location.col1);
+        buffer += ",\"endLine\":" + std::to_string(location.line2);
+        buffer += ",\"endColumn\":" + std::to_string(location.col2 + 1) + "}";
+    }
+    buffer += '}';
 }
 
 
 
 
 
-/***** ADLCOMPILEWARNING CLASS *****/
+/***** LOCATION STRUCT *****/
 
-/* Function that prints the compilation warning to the given output stream. */
-std::ostream& ADLCompileWarning::print(std::ostream& os) const {
-    const DebugInfo& debug = this->debug;
+/* Constructor for the Location struct, which takes the DebugInfo to compact. Its include path is added to the source manager if it's new. */
+Location::Location(const DebugInfo& debug) :
+    Location(source_manager.trail(debug.filenames), debug)
+{}
+
+/* Constructor for the Location struct, which takes the id of the include path of the given DebugInfo (which is thus known already) and the DebugInfo to take the position from. The byte offset is looked up right away, while the file is certainly still around. */
+Location::Location(trail_t trail, const DebugInfo& debug) :
+    trail(trail),
+    line1((uint32_t) debug.line1),
+    col1((uint32_t) debug.col1),
+    line2((uint32_t) debug.line2),
+    col2((uint32_t) debug.col2),
+    offset(debug.line1 > 0 ? (uint32_t) source_manager.trail_offset(trail, debug.line1, debug.col1) : 0)
+{}
+
+
+
+
+
+/***** FORMATTING *****/
+
+/* Formats the given message template by replacing each '{i}' in it with the i'th of the given arguments (where i is a single digit). */
+std::string Exceptions::format_message(const char* format, const std::string* args, size_t n_args) {
+    std::string result;
+    for (const char* c = format; *c != '\0'; c++) {
+        // If this is a placeholder, write the argument instead
+        if (c[0] == '{' && c[1] >= '0' && c[1] <= '9' && c[2] == '}') {
+            size_t i = (size_t) (c[1] - '0');
+            if (i < n_args) { result += args[i]; }
+            c += 2;
+            continue;
+        }
+
+        // Otherwise, copy the character as-is
+        result += *c;
+    }
+    return result;
+}
+
+/* Renders a diagnostic of the given kind to the end of the given buffer, using its location, its warning type (only used for warnings) and its formatted message. Escape sequences for colours are only written if colour is true. */
+void Exceptions::render_diagnostic(std::string& buffer, DiagnosticKind kind, WarningType type, const Location& location, const std::string& message, bool colour) {
+    // Decide on the label and the colours to use
+    const char* label;
+    const char* normal;
+    const char* bold;
+    switch (kind) {
+        case DiagnosticKind::error:
+        case DiagnosticKind::compile_error:
+            label = "error: ";
+            normal = "31";
+            bold = "31;1";
+            break;
+
+        case DiagnosticKind::warning:
+        case DiagnosticKind::compile_warning:
+            label = "warning: ";
+            normal = "35";
+            bold = "35;1";
+            break;
+
+        default:
+            label = "note: ";
+            normal = "36";
+            bold = "36;1";
+            break;
+    }
+    bool has_position = kind == DiagnosticKind::compile_error || kind == DiagnosticKind::compile_warning || kind == DiagnosticKind::note;
+    const std::vector<std::string>& filenames = location.filenames();
 
     // Always print the possible list of breadcrumbs first
-    for (size_t i = 0; i < this->filenames.size() - 1; i++) {
-        os << "\033[1m" << this->filenames[i] << ":\033[0m" << endl << "--> ";
+    for (size_t i = 0; i < filenames.size() - 1; i++) {
+        style(buffer, colour, "1");
+        buffer += filenames[i];
+        buffer += ':';
+        style(buffer, colour, "0");
+        buffer += "\n--> ";
     }
 
-    // Then, we can also always print the filename itself
-    os << "\033[1m" << this->filenames[this->filenames.size() - 1] << ":" << debug.line1 << ":" << debug.col1  << ":" << " \033[35mwarning: \033[0m" << this->message << " [\033[35;1m" << warningtype_names.at(this->type) << "\033[0m]" << endl;
+    // Then, we can also always print the filename itself, followed by the position (if any)
+    style(buffer, colour, "1");
+    buffer += filenames[filenames.size() - 1];
+    buffer += ':';
+    if (has_position) {
+        buffer += std::to_string(location.line1);
+        buffer += ':';
+        buffer += std::to_string(location.col1);
+        buffer += ':';
+    }
 
-    // Print the line number + spacing
-    std::string strline = std::to_string(debug.line1);
-    for (size_t i = strline.size(); i < 5; i++) { os << ' '; }
-    os << strline;
-    os << " | ";
-
-    // Print the raw_line, with the correct characters in red
-    const std::string& sraw = debug.raw_line.snippet;
-    size_t line_i = debug.line1;
-    bool red_mode = false;
-    for (size_t i = 0; i < sraw.size(); i++) {
-        // If we're at the correct pos in the string, write the red-marker
-        if (line_i == debug.line1 && i + 1 == debug.col1) {
-            os << "\033[35;1m";
-            red_mode = true;
-        }
+    // Continue with the label & the message, and the type of warning for warnings
+    buffer += ' ';
+    style(buffer, colour, normal);
+    buffer += label;
+    style(buffer, colour, "0");
+    buffer += message;
+    if (severity_of(kind) == Severity::warning) {
+        buffer += " [";
+        style(buffer, colour, bold);
+        buffer += warningtype_names.at(type);
+        style(buffer, colour, "0");
+        buffer += ']';
+    }
+    buffer += '\n';
+    if (!has_position) { return; }
 
-        // Write the character, possibly doing neat newline padding
-        os << sraw[i];
-        if (i < sraw.size() - 1 && sraw[i] == '\n') {
-            if (red_mode) { os << "\033[0m"; }
-            os << "      | ";
-            if (red_mode) { os << "\033[35;1m"; }
-        }
+    // Cut the line the diagnostic starts on from its file, if we've seen that file
+    LineSnippet snippet;
+    file_t file = source_manager.find(filenames[filenames.size() - 1]);
+    if (file == SourceManager::none || !source_manager.snippet(file, location.line1, location.col1, snippet)) { return; }
 
-        // If we're at the correct pos in the string, go back to white text
-        if (line_i == debug.line2 && i + 1 == debug.col2) {
-            os << "\033[0m";
-            red_mode = false;
-        }
+    // Print the line number + spacing
+    std::string strline = std::to_string(location.line1);
+    if (strline.size() < 5) { buffer.append(5 - strline.size(), ' '); }
+    buffer += strline;
+    buffer += " | ";
+
+    // Print the snippet, with the marked characters in colour; a span that continues on a later line is marked until the end of it
+    const std::string& sraw = snippet.snippet;
+    size_t mark1 = std::min(location.col1 > snippet.col1 ? location.col1 - snippet.col1 : 0, sraw.size());
+    size_t mark2 = sraw.size();
+    if (location.line2 == location.line1) { mark2 = std::min(location.col2 >= snippet.col1 ? location.col2 - snippet.col1 + 1 : 0, sraw.size()); }
+    if (mark2 < mark1) { mark2 = mark1; }
+    buffer.append(sraw, 0, mark1);
+    if (mark2 > mark1) {
+        style(buffer, colour, bold);
+        buffer.append(sraw, mark1, mark2 - mark1);
+        style(buffer, colour, "0");
     }
-    // Add a newline if the last character wasn't
-    if (sraw[sraw.size() - 1] != '\n') { os << '\n'; }
+    buffer.append(sraw, mark2, sraw.size() - mark2);
+    buffer += '\n';
 
     // Next, write the same but with spaces and wiggly bits
-    os << "      | ";
-    for (size_t i = 1; i < debug.col1; i++) { os << ' '; }
-    // Write enough '^'s
-    os << "\033[35;1m";
-    for (size_t i = 0; i < debug.col2 - debug.col1 + 1; i++) { os << '^'; }
-    os << "\033[0m" << endl;
+    buffer += "      | ";
+    size_t offset = location.col1 > snippet.col1 ? location.col1 - snippet.col1 : 0;
+    buffer.append(offset, ' ');
+    // Write enough '^'s (at least one), where spans over multiple lines are marked until the end of their first line, and no span goes past the window
+    size_t n_carets = location.col2 >= location.col1 ? location.col2 - location.col1 + 1 : 1;
+    if (location.line2 != location.line1) { n_carets = sraw.size() > offset ? sraw.size() - offset : 1; }
+    if (offset + n_carets > SourceManager::snippet_width) { n_carets = offset < SourceManager::snippet_width ? SourceManager::snippet_width - offset : 1; }
+    style(buffer, colour, bold);
+    buffer.append(n_carets, '^');
+    style(buffer, colour, "0");
+    buffer += '\n';
+}
 
-    // Done
-    return os;
+/* Prints a diagnostic of the given kind to the given output stream in one write, using its location, its warning type (only used for warnings) and its formatted message. */
+std::ostream& Exceptions::print_diagnostic(std::ostream& os, DiagnosticKind kind, WarningType type, const DebugInfo& debug, const std::string& message, bool colour) {
+    std::string buffer;
+    render_diagnostic(buffer, kind, type, Location(debug), message, colour);
+    return os.write(buffer.data(), buffer.size());
 }
 
 
 
 
 
-/***** ADLNOTE CLASS *****/
+/***** ADLERROR CLASS *****/
 
-/* Copies the ADLNote polymorphically. */
-ADLNote* ADLNote::copy() const { return new ADLNote(*this); }
+/* Function that prints the error to the given output stream. */
+std::ostream& ADLError::print(std::ostream& os) const {
+    return print_diagnostic(os, DiagnosticKind::error, WarningType::unknown, this->debug, this->message());
+}
 
-/* Function that prints the note to the given output stream. */
-std::ostream& ADLNote::print(std::ostream& os) const {
-    const DebugInfo& debug = this->debug;
 
-    // Always print the possible list of breadcrumbs first
-    for (size_t i = 0; i < this->filenames.size() - 1; i++) {
-        os << "\033[1m" << this->filenames[i] << ":\033[0m" << endl << "--> ";
-    }
 
-    // Then, we can also always print the filename itself
-    os << "\033[1m" << this->filenames[this->filenames.size() - 1] << ":" << debug.line1 << ":" << debug.col1  << ":" << " \033[36mnote: \033[0m" << this->message << endl;
 
-    // Print the line number + spacing
-    std::string strline = std::to_string(debug.line1);
-    for (size_t i = strline.size(); i < 5; i++) { os << ' '; }
-    os << strline;
-    os << " | ";
-
-    // Print the raw_line, with the correct characters in cyan
-    const std::string& sraw = debug.raw_line.snippet;
-    size_t line_i = debug.line1;
-    bool red_mode = false;
-    for (size_t i = 0; i < sraw.size(); i++) {
-        // If we're at the correct pos in the string, write the red-marker
-        if (line_i == debug.line1 && i + 1 == debug.col1) {
-            os << "\033[36;1m";
-            red_mode = true;
-        }
 
-        // Write the character, possibly doing neat newline padding
-        os << sraw[i];
-        if (i < sraw.size() - 1 && sraw[i] == '\n') {
-            if (red_mode) { os << "\033[0m"; }
-            os << "      | ";
-            if (red_mode) { os << "\033[36;1m"; }
-        }
+/***** ADLCOMPILEERROR CLASS *****/
+
+/* Function that prints the compilation error to the given output stream. */
+std::ostream& ADLCompileError::print(std::ostream& os) const {
+    return print_diagnostic(os, DiagnosticKind::compile_error, WarningType::unknown, this->debug, this->message());
+}
+
+
+
+
+
+/***** ADLWARNING CLASS *****/
+
+/* Function that prints the warning to the given output stream. */
+std::ostream& ADLWarning::print(std::ostream& os) const {
+    return print_diagnostic(os, DiagnosticKind::warning, this->type, this->debug, this->message());
+}
+
+
+
+
+
+/***** ADLCOMPILEWARNING CLASS *****/
+
+/* Function that prints the compilation warning to the given output stream. */
+std::ostream& ADLCompileWarning::print(std::ostream& os) const {
+    return print_diagnostic(os, DiagnosticKind::compile_warning, this->type, this->debug, this->message());
+}
+
 
-        // If we're at the correct pos in the string, go back to white text
-        if (line_i == debug.line2 && i + 1 == debug.col2) {
-            os << "\033[0m";
-            red_mode = false;
-        }
-    }
-    // Add a newline if the last character wasn't
-    if (sraw[sraw.size() - 1] != '\n') { os << '\n'; }
 
-    // Next, write the same but with spaces and wiggly bits
-    os << "      | ";
-    for (size_t i = 1; i < debug.col1; i++) { os << ' '; }
-    // Write enough '^'s
-    os << "\033[36;1m";
-    for (size_t i = 0; i < debug.col2 - debug.col1 + 1; i++) { os << '^'; }
-    os << "\033[0m" << endl;
 
-    // We're done!
-    return os;
+
+/***** ADLNOTE CLASS *****/
+
+/* Copies the ADLNote polymorphically. */
+ADLNote* ADLNote::copy() const { return new ADLNote(*this); }
+
+/* Function that prints the note to the given output stream. */
+std::ostream& ADLNote::print(std::ostream& os) const {
+    return print_diagnostic(os, DiagnosticKind::note, WarningType::unknown, this->debug, this->message());
 }
 
 
@@ -261,112 +490,172 @@ std::ostream& ADLNote::print(std::ostream& os) const {
 
 /***** EXCEPTIONHANDLER CLASS *****/
 
+/* The handler that diagnostics logged on this thread go to, if any. */
+thread_local ExceptionHandler* ExceptionHandler::active = nullptr;
+
+
+
+
 /* Default constructor for the ExceptionHandler class, which optionally takes whether or not exceptions should be printed immediately and the initial size of the internal array. */
 ExceptionHandler::ExceptionHandler(bool print_on_add, size_t initial_capacity) :
-    length(0),
-    max_length(initial_capacity),
+    n_errors(0),
+    n_warnings(0),
+    n_omitted_errors(0),
+    n_omitted_warnings(0),
+    repeat_line(0),
+    n_flushed(0),
+    n_reported_omitted(0),
+    reported_exhausted(false),
     print_on_add(print_on_add),
-    toplevel_suppressed((WarningType) 0),
-    config_suppressed((WarningType) 0)
+    colour(isatty(fileno(stderr))),
+    output_format(DiagnosticsFormat::text),
+    max_errors(0),
+    max_warnings(0),
+    suppressed_types((WarningType) 0)
 {
     // Reserve space for the initial capacity
-    this->exceptions = new ADLException*[this->max_length];
+    this->diagnostics.reserve(initial_capacity);
 }
 
 /* Copy constructor for the ExceptionHandler class. */
 ExceptionHandler::ExceptionHandler(const ExceptionHandler& other) :
-    length(other.length),
-    max_length(other.max_length),
+    diagnostics(other.diagnostics),
+    arguments(other.arguments),
+    sources(other.sources),
+    n_errors(other.n_errors),
+    n_warnings(other.n_warnings),
+    n_omitted_errors(other.n_omitted_errors),
+    n_omitted_warnings(other.n_omitted_warnings),
+    repeat_line(other.repeat_line),
+    n_flushed(other.n_flushed),
+    n_reported_omitted(other.n_reported_omitted),
+    reported_exhausted(other.reported_exhausted),
     print_on_add(other.print_on_add),
-    toplevel_suppressed(other.toplevel_suppressed),
-    config_suppressed(other.config_suppressed)
+    colour(other.colour),
+    output_format(other.output_format),
+    max_errors(other.max_errors),
+    max_warnings(other.max_warnings),
+    suppressed_types(other.suppressed_types)
 {
-    // Allocate a new exceptions list
-    this->exceptions = new ADLException*[this->max_length];
-    // Iterate through all the existing exceptions to copy them
-    for (size_t i = 0; i < this->length; i++) {
-        this->exceptions[i] = other.exceptions[i]->copy();
+    // The copy needs the files just as much
+    for (size_t i = 0; i < this->sources.size(); i++) {
+        source_manager.retain(this->sources[i]);
     }
 }
 
 /* Move constructor for the ExceptionHandler class. */
 ExceptionHandler::ExceptionHandler(ExceptionHandler&& other) :
-    exceptions(other.exceptions),
-    length(other.length),
-    max_length(other.max_length),
+    diagnostics(std::move(other.diagnostics)),
+    arguments(std::move(other.arguments)),
+    sources(std::move(other.sources)),
+    n_errors(other.n_errors),
+    n_warnings(other.n_warnings),
+    n_omitted_errors(other.n_omitted_errors),
+    n_omitted_warnings(other.n_omitted_warnings),
+    repeat_line(other.repeat_line),
+    n_flushed(other.n_flushed),
+    n_reported_omitted(other.n_reported_omitted),
+    reported_exhausted(other.reported_exhausted),
     print_on_add(other.print_on_add),
-    toplevel_suppressed(other.toplevel_suppressed),
-    config_suppressed(other.config_suppressed)
+    colour(other.colour),
+    output_format(other.output_format),
+    max_errors(other.max_errors),
+    max_warnings(other.max_warnings),
+    suppressed_types(other.suppressed_types)
 {
-    // Set the other's value to nullptr to prevent it from deallocating the exceptions
-    other.exceptions = nullptr;
+    // Make sure the other doesn't release the files we took over
+    other.sources.clear();
 }
 
-/* Destructor for the ExceptionHandler class. */
+/* Destructor for the ExceptionHandler class, which releases the files its diagnostics point to. */
 ExceptionHandler::~ExceptionHandler() {
-    // If our list isn't a nullptr, deallocate it and all exceptions inside it
-    if (this->exceptions != nullptr) {
-        for (size_t i = 0; i < this->length; i++) {
-            delete this->exceptions[i];
-        }
-        delete[] this->exceptions;
+    for (size_t i = 0; i < this->sources.size(); i++) {
+        source_manager.release(this->sources[i]);
     }
 }
 
 
 
-/* Resizes the internal array, by doubling its size. */
-void ExceptionHandler::resize() {
-    // First, allocate space for the new array
-    size_t new_max_length = this->max_length * 2;
-    ADLException** new_exceptions = new ADLException*[new_max_length];
+/* Returns whether warnings of the given type are suppressed everywhere or, by the active SuppressionList, at the given position. */
+bool ExceptionHandler::suppressed(WarningType type, const DebugInfo& at) const {
+    return this->suppressed(type) || SuppressionList::active_suppresses(type, at);
+}
+
+/* Counts the given exception, and returns whether it should be stored. It isn't if it's a suppressed warning, if there are too many of its severity already or if it's folded into the previous diagnostic as a repeat; the latter only happens for exceptions without notes. */
+bool ExceptionHandler::admit(const ADLException& except, bool has_notes) {
+    // Ignore warnings that are suppressed everywhere or where they point to altogether
+    if (except.severity == Severity::warning) {
+        const ADLWarning& warning = (const ADLWarning&) except;
+        if (this->suppressed(warning.type, except.debug)) {
+            #ifdef DEBUG
+            cout << "[   Exception   ] Suppressed warning of type '" << warningtype_names.at(warning.type) << "'" << endl;
+            #endif
+            return false;
+        }
+    }
 
-    // Move all the elements over
-    for (size_t i = 0; i < this->length; i++) {
-        new_exceptions[i] = this->exceptions[i];
+    // Count the others, only keeping as many as we may
+    if (except.severity == Severity::error) {
+        ++this->n_errors;
+        if (this->max_errors > 0 && this->n_errors > this->max_errors) { ++this->n_omitted_errors; return false; }
+    } else if (except.severity == Severity::warning) {
+        ++this->n_warnings;
+        if (this->max_warnings > 0 && this->n_warnings > this->max_warnings) { ++this->n_omitted_warnings; return false; }
     }
 
-    // Replace the existing lists
-    delete this->exceptions;
-    this->max_length = new_max_length;
-    this->exceptions = new_exceptions;
+    // Fold the exception into the previous diagnostic if it says exactly the same thing on the same or the next line, as long as that one hasn't been printed yet
+    if (!has_notes && has_position(except.kind) && except.kind != DiagnosticKind::note && this->diagnostics.size() > this->n_flushed) {
+        Diagnostic& last = this->diagnostics.back();
+        if (last.kind == except.kind && last.format == except.format && except.debug.line1 >= this->repeat_line && except.debug.line1 <= this->repeat_line + 1 && last.n_args == except.args.size() && std::equal(except.args.begin(), except.args.end(), this->arguments.begin() + last.args) && last.location.filenames() == except.debug.filenames) {
+            ++last.repeats;
+            this->repeat_line = except.debug.line2;
+            return false;
+        }
+    }
+    this->repeat_line = except.debug.line2;
+    return true;
 }
 
+/* Stores a compact record of the given exception. */
+void ExceptionHandler::add(const ADLException& except) {
+    // Diagnostics usually follow others in the same file, in which case we can reuse their include path (and already keep their file around)
+    bool same_file = !this->diagnostics.empty() && this->diagnostics.back().location.filenames() == except.debug.filenames;
+
+    // Compact the location, store the arguments in their table and let the record refer to those
+    Diagnostic diagnostic;
+    diagnostic.kind = except.kind;
+    diagnostic.n_args = (uint8_t) except.args.size();
+    diagnostic.type = except.severity == Severity::warning ? ((const ADLWarning&) except).type : WarningType::unknown;
+    diagnostic.location = same_file ? Location(this->diagnostics.back().location.trail, except.debug) : Location(except.debug);
+    diagnostic.args = (uint32_t) this->arguments.size();
+    diagnostic.format = except.format;
+    diagnostic.repeats = 0;
+    this->arguments.insert(this->arguments.end(), except.args.begin(), except.args.end());
+    this->diagnostics.push_back(diagnostic);
+
+    // Keep the file it points to around, so we can still cut its snippet once we render it
+    if (!same_file) { this->retain(source_manager.find(diagnostic.location.path())); }
+}
 
-
-/* Private function that adds a single note to the parser. */
-void ExceptionHandler::add_note(const ADLNote& note) {
-    // Note the note in our internal list, resizing as needed
-    if (this->length >= this->max_length) { this->resize(); }
-    this->exceptions[this->length++] = note.copy();
-    
-    // Don't forget to print it
-    if (this->print_on_add) { note.print(cerr); }
+/* Retains the given file in the source manager, unless the handler already does. */
+void ExceptionHandler::retain(file_t file) {
+    if (file == SourceManager::none || std::find(this->sources.begin(), this->sources.end(), file) != this->sources.end()) { return; }
+    source_manager.retain(file);
+    this->sources.push_back(file);
 }
 
 
 
 /* Adds a new exception to the handler. */
 ExceptionHandler& ExceptionHandler::log(const ADLException& except) {
-    // If the exception is actually a warning, possibly ignore it
-    if (dynamic_cast<const ADLWarning*>(&except)) {
-        const ADLWarning& warning = (const ADLWarning&) except;
-        if ((this->toplevel_suppressed | this->config_suppressed) & warning.type) {
-            // It's one of the suppressed types; just return, without doing anything
-            #ifdef DEBUG
-            cout << "[   Exception   ] Suppressed warning of type '" << warningtype_names.at(warning.type) << "'" << endl;
-            #endif
-            return *this;
-        }
-    }
+    // If the exception is a suppressed warning, one too many or a repeat, we don't need to store it
+    if (!this->admit(except, false)) { return *this; }
 
     // Log the exception in our internal list
-    if (this->length >= this->max_length) { this->resize(); }
-    this->exceptions[this->length++] = except.copy();
-    if (dynamic_cast<const ADLError*>(&except)) { ++this->n_errors; }
+    this->add(except);
 
     // Don't forget to print it
-    if (this->print_on_add) { except.print(cerr); }
+    if (this->print_on_add) { this->flush(cerr); }
 
     // When done, return ourselves so we may potentially be thrown
     return *this;
@@ -374,15 +663,156 @@ ExceptionHandler& ExceptionHandler::log(const ADLException& except) {
 
 
 
-/* Neatly prints all exceptions in this ExceptionHandler. */
-std::ostream& Exceptions::operator<<(std::ostream& os, const ExceptionHandler& handler) {
-    // Simply print each of the exceptions
-    for (size_t i = 0; i < handler.length; i++) {
-        handler.exceptions[i]->print(os);
+/* Renders the diagnostics in the range [first, last) to one string in the output format, sorted by location and with duplicates left out. Notes stay with the diagnostic they accompany. */
+std::string ExceptionHandler::render(size_t first, size_t last) const {
+    std::vector<DiagnosticGroup> groups = sorted_groups(*this, first, last);
+    std::string buffer;
+
+    switch (this->output_format) {
+        case DiagnosticsFormat::json:
+            // One object per line for each diagnostic, with its notes nested in it
+            for (size_t i = 0; i < groups.size(); i++) {
+                append_json_diagnostic(buffer, *this, this->diagnostics[groups[i].first]);
+                buffer += ",\"repeats\":" + std::to_string(this->diagnostics[groups[i].first].repeats);
+                buffer += ",\"notes\":[";
+                for (size_t j = groups[i].first + 1; j < groups[i].last; j++) {
+                    if (j > groups[i].first + 1) { buffer += ','; }
+                    append_json_diagnostic(buffer, *this, this->diagnostics[j]);
+                    buffer += '}';
+                }
+                buffer += "]}\n";
+            }
+            break;
+
+        case DiagnosticsFormat::sarif:
+            // A single SARIF log with one result per diagnostic, where its notes are related locations
+            buffer += "{\"version\":\"2.1.0\",\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"runs\":[{\"tool\":{\"driver\":{\"name\":\"adlc\"}},\"results\":[";
+            for (size_t i = 0; i < groups.size(); i++) {
+                const Diagnostic& diagnostic = this->diagnostics[groups[i].first];
+                if (i > 0) { buffer += ','; }
+                buffer += "{\"ruleId\":";
+                append_json_string(buffer, severity_of(diagnostic.kind) == Severity::warning ? warningtype_names.at(diagnostic.type) : kind_name(diagnostic.kind));
+                buffer += ",\"level\":\"";
+                buffer += severity_name(severity_of(diagnostic.kind));
+                buffer += "\",\"message\":{\"text\":";
+                append_json_string(buffer, this->message(diagnostic));
+                buffer += "},\"locations\":[{";
+                append_sarif_location(buffer, diagnostic);
+                buffer += "}],\"relatedLocations\":[";
+                for (size_t j = groups[i].first + 1; j < groups[i].last; j++) {
+                    if (j > groups[i].first + 1) { buffer += ','; }
+                    buffer += "{\"id\":" + std::to_string(j - groups[i].first - 1) + ",";
+                    append_sarif_location(buffer, this->diagnostics[j]);
+                    buffer += ",\"message\":{\"text\":";
+                    append_json_string(buffer, this->message(this->diagnostics[j]));
+                    buffer += "}}";
+                }
+                buffer += ']';
+                if (diagnostic.repeats > 0) { buffer += ",\"properties\":{\"repeats\":" + std::to_string(diagnostic.repeats) + "}"; }
+                buffer += '}';
+            }
+            buffer += ']';
+            if (this->n_omitted_errors + this->n_omitted_warnings > 0 || this->exhausted()) {
+                buffer += ",\"properties\":{\"stopped\":";
+                buffer += this->exhausted() ? "true" : "false";
+                buffer += ",\"omittedErrors\":" + std::to_string(this->n_omitted_errors);
+                buffer += ",\"omittedWarnings\":" + std::to_string(this->n_omitted_warnings) + "}";
+            }
+            buffer += "}]}\n";
+            break;
+
+        default:
+            // Render them the way GCC does
+            for (size_t i = 0; i < groups.size(); i++) {
+                for (size_t j = groups[i].first; j < groups[i].last; j++) {
+                    this->render(buffer, this->diagnostics[j]);
+                    if (this->diagnostics[j].repeats > 0) { render_repeats(buffer, this->diagnostics[j].location, this->diagnostics[j].repeats, this->colour); }
+                }
+            }
+            break;
+    }
+
+    return buffer;
+}
+
+/* Appends the diagnostics of the given handler to this one, as if they were logged here after everything logged so far. Merging the handlers of separate compilations in a fixed order thus always gives the same result, no matter in which order the compilations finished. */
+ExceptionHandler& ExceptionHandler::merge(const ExceptionHandler& other) {
+    // Copy the table first, remembering where the other's entries start in ours
+    uint32_t args_offset = (uint32_t) this->arguments.size();
+    this->arguments.insert(this->arguments.end(), other.arguments.begin(), other.arguments.end());
+
+    // Then copy the records, pointing them to their entries in our table
+    this->diagnostics.reserve(this->diagnostics.size() + other.diagnostics.size());
+    for (size_t i = 0; i < other.diagnostics.size(); i++) {
+        Diagnostic diagnostic = other.diagnostics[i];
+        diagnostic.args += args_offset;
+        this->diagnostics.push_back(diagnostic);
+    }
+    this->n_errors += other.n_errors;
+    this->n_warnings += other.n_warnings;
+    this->n_omitted_errors += other.n_omitted_errors;
+    this->n_omitted_warnings += other.n_omitted_warnings;
+    for (size_t i = 0; i < other.sources.size(); i++) {
+        this->retain(other.sources[i]);
     }
 
-    // When all is done, return the stream
-    return os;
+    // Print them if we're supposed to
+    if (this->print_on_add) { this->flush(std::cerr); }
+    return *this;
+}
+
+/* Renders the summary of the diagnostics that were left out since the last call to the end of the given buffer, if there is any news. */
+void ExceptionHandler::render_summary(std::string& buffer) {
+    // Only say something if anything changed since we last did, and leave SARIF logs alone since they carry the summary themselves
+    size_t n_omitted = this->n_omitted_errors + this->n_omitted_warnings;
+    bool exhausted = this->exhausted();
+    if (this->output_format == DiagnosticsFormat::sarif || (n_omitted == this->n_reported_omitted && exhausted == this->reported_exhausted)) { return; }
+
+    if (this->output_format == DiagnosticsFormat::json) {
+        buffer += "{\"kind\":\"summary\",\"stopped\":";
+        buffer += exhausted ? "true" : "false";
+        buffer += ",\"omitted_errors\":" + std::to_string(this->n_omitted_errors);
+        buffer += ",\"omitted_warnings\":" + std::to_string(this->n_omitted_warnings) + "}\n";
+    } else {
+        if (exhausted && !this->reported_exhausted) {
+            style(buffer, this->colour, "36");
+            buffer += "note: ";
+            style(buffer, this->colour, "0");
+            buffer += "stopped after reaching the limit of " + std::to_string(this->max_errors) + " errors\n";
+        }
+        if (n_omitted != this->n_reported_omitted) {
+            style(buffer, this->colour, "36");
+            buffer += "note: ";
+            style(buffer, this->colour, "0");
+            buffer += std::to_string(this->n_omitted_errors) + " more errors and " + std::to_string(this->n_omitted_warnings) + " more warnings were left out\n";
+        }
+    }
+    this->n_reported_omitted = n_omitted;
+    this->reported_exhausted = exhausted;
+}
+
+/* Writes all diagnostics that haven't been written yet to the given output stream in one go, sorted by location and with duplicates left out. */
+std::ostream& ExceptionHandler::flush(std::ostream& os) {
+    std::string buffer = this->render(this->n_flushed, this->diagnostics.size());
+    this->n_flushed = this->diagnostics.size();
+    this->render_summary(buffer);
+    return os.write(buffer.data(), buffer.size());
+}
+
+
+
+/* Returns the handler that diagnostics logged on this thread go to. If no handler is active, returns the process-wide error_handler. */
+ExceptionHandler& ExceptionHandler::current() {
+    return ExceptionHandler::active != nullptr ? *ExceptionHandler::active : error_handler;
+}
+
+
+
+/* Neatly prints all exceptions in this ExceptionHandler. */
+std::ostream& Exceptions::operator<<(std::ostream& os, const ExceptionHandler& handler) {
+    // Render all diagnostics in one go
+    std::string buffer = handler.render(0, handler.diagnostics.size());
+    return os.write(buffer.data(), buffer.size());
 }
 
 
@@ -397,10 +827,21 @@ ExceptionHandler& ExceptionHandler::operator=(ExceptionHandler&& other) {
 void Exceptions::swap(ExceptionHandler& eh1, ExceptionHandler& eh2) {
     using std::swap;
 
-    swap(eh1.exceptions, eh2.exceptions);
-    swap(eh1.length, eh2.length);
-    swap(eh1.max_length, eh2.max_length);
+    swap(eh1.diagnostics, eh2.diagnostics);
+    swap(eh1.arguments, eh2.arguments);
+    swap(eh1.sources, eh2.sources);
+    swap(eh1.n_errors, eh2.n_errors);
+    swap(eh1.n_warnings, eh2.n_warnings);
+    swap(eh1.n_omitted_errors, eh2.n_omitted_errors);
+    swap(eh1.n_omitted_warnings, eh2.n_omitted_warnings);
+    swap(eh1.repeat_line, eh2.repeat_line);
+    swap(eh1.n_flushed, eh2.n_flushed);
+    swap(eh1.n_reported_omitted, eh2.n_reported_omitted);
+    swap(eh1.reported_exhausted, eh2.reported_exhausted);
     swap(eh1.print_on_add, eh2.print_on_add);
-    swap(eh1.toplevel_suppressed, eh2.toplevel_suppressed);
-    swap(eh1.config_suppressed, eh2.config_suppressed);
+    swap(eh1.colour, eh2.colour);
+    swap(eh1.output_format, eh2.output_format);
+    swap(eh1.max_errors, eh2.max_errors);
+    swap(eh1.max_warnings, eh2.max_warnings);
+    swap(eh1.suppressed_types, eh2.suppressed_types);
 }
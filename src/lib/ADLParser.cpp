@@ -4,7 +4,7 @@
  * Created:
  *   11/12/2020, 5:38:51 PM
  * Last edited:
- *   11/02/2021, 16:52:13
+ *   18/10/2026, 19:43:52
  * Auto updated?
  *   Yes
  *
@@ -16,6 +16,9 @@
 **/
 
 #include <iostream>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
 
 #include "ADLMeta.hpp"
 #include "ADLTypeDef.hpp"
@@ -36,9 +39,12 @@
 #include "ADLReference.hpp"
 #include "ADLSnippet.hpp"
 
+#include "ADLArena.hpp"
+#include "ADLInternTable.hpp"
 #include "SymbolStack.hpp"
 #include "ADLPreprocessor.hpp"
 #include "ParseExceptions.hpp"
+#include "SuppressionList.hpp"
 #include "ADLParser.hpp"
 
 using namespace std;
@@ -57,6 +63,105 @@ using namespace ArgumentParser::Parser;
     if ((I) >= (STACK).size()) { (SYMBOL) = (Symbol*) &t_empty; } \
     else { (SYMBOL) = (STACK)[(I)++]; }
 
+/* Returns the location of the given terminal, or the given fallback if it's the empty terminal below the bottom of the stack (which isn't anywhere in a file). */
+static inline const DebugInfo& debug_or(Terminal* term, const DebugInfo& fallback) {
+    return term->type() == TokenType::empty ? fallback : term->debug();
+}
+
+/* Converts the given value token to its non-terminal equivalent. Returns a nullptr if the token isn't a value at all. */
+static ADLNode* value_node(Token* token) {
+    switch(token->type) {
+        case TokenType::string:
+            return new ADLString(token->debug, token->raw);
+
+        case TokenType::regex:
+            return new ADLRegex(token->debug, token->raw);
+
+        case TokenType::number:
+            return new ADLNumber(token->debug, ((ValueToken<long>*) token)->value);
+
+        case TokenType::decimal:
+            return new ADLDecimal(token->debug, ((ValueToken<double>*) token)->value);
+
+        case TokenType::boolean:
+            return new ADLBoolean(token->debug, ((ValueToken<bool>*) token)->value);
+
+        case TokenType::reference:
+            {
+                // The tokenizer already found the dot that splits the reference into identifier & property
+                size_t dot = ((ValueToken<size_t>*) token)->value;
+                std::string_view raw(token->raw);
+                std::string_view identifier = raw.substr(0, dot);
+
+                // Infer the type of the reference
+                IdentifierType reference_type = IdentifierType::positional;
+                if (identifier == "meta") {
+                    // Meta
+                    reference_type = IdentifierType::meta;
+                } else if (identifier.size() > 1 && identifier[0] == '-' && identifier[1] == '-') {
+                    // Longlabel
+                    reference_type = IdentifierType::longlabel;
+                } else if (identifier[0] == '-') {
+                    // Shortlabel
+                    reference_type = IdentifierType::shortlabel;
+                } else if (identifier[0] == '<') {
+                    // Type
+                    reference_type = IdentifierType::type;
+                }
+
+                // With that over, create new debug info's for the two identifiers we'll use
+                DebugInfo didentifier = token->debug;
+                DebugInfo dproperty = token->debug;
+                didentifier.col2 = token->debug.col1 + dot - 1;
+                dproperty.col1 = token->debug.col1 + dot + 1;
+
+                // Return the reference with both identifiers, moving the debug info's in and interning the split strings
+                return new ADLReference(
+                    token->debug,
+                    new ADLIdentifier(std::move(didentifier), identifier, reference_type),
+                    new ADLIdentifier(std::move(dproperty), raw.substr(dot + 1), IdentifierType::property)
+                );
+            }
+
+        case TokenType::snippet:
+            return new ADLSnippet(token->debug, token->raw);
+
+        default:
+            // Not a value
+            return nullptr;
+
+    }
+}
+
+/* If a config's values are about to be parsed, consumes the entire run of value tokens up to the next non-value token (typically the semicolon) in one go and pushes them as a single ADLValues NonTerminal. This avoids merging each value separately by re-entering reduce(). Returns the name of the applied rule, or an empty string if it didn't apply. */
+template <class INPUT>
+static std::string parse_values(INPUT& in, Token*& lookahead, SymbolStack& stack) {
+    // Only do this directly after a config's name, so strings following @warning & co. are handled by reduce()
+    Symbol* top = *stack.begin();
+    if (!top->is_terminal || ((Terminal*) top)->type() != TokenType::config) { return ""; }
+
+    // Start the values node with the first value
+    ADLNode* value = value_node(lookahead);
+    if (value == nullptr) { return ""; }
+    ADLValues* values = new ADLValues(value->debug, value);
+
+    // Push it already, so the stack frees it if reading the next token throws; then add the others while the lookahead is a value
+    stack.add_nonterminal(new NonTerminal(values));
+    delete lookahead;
+    lookahead = in.pop();
+    while ((value = value_node(lookahead)) != nullptr) {
+        values->add_node(value);
+
+        // Make the debug information span all values so far
+        values->debug.line2 = value->debug.line2;
+        values->debug.col2 = value->debug.col2;
+
+        delete lookahead;
+        lookahead = in.pop();
+    }
+    return "values-run";
+}
+
 /* Tries to match the top of the stack and the lookahead with one of the hardcoded grammar rules. Returns whether it succeeded or not. */
 std::string reduce(ParseState& state, const std::string& filename, Token* lookahead, SymbolStack& stack) {
     // Iterates over each stack symbol, returning the empty terminal if it went out-of-range
@@ -120,73 +225,43 @@ std::string reduce(ParseState& state, const std::string& filename, Token* lookah
 
                 case TokenType::string:
                     // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
-                    prev_nonterm = new ADLString(term->debug(), term->raw());
+                    prev_nonterm = value_node(term->token());
                     // In the string's case, it's either merging with a value or with a warning or error token
                     goto modifier_string;
                 
                 case TokenType::regex:
                     // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
-                    prev_nonterm = new ADLRegex(term->debug(), term->raw());
+                    prev_nonterm = value_node(term->token());
                     applied_rule = "regex";
                     goto value_merge;
                 
                 case TokenType::number:
                     // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
-                    prev_nonterm = new ADLNumber(term->debug(), term->value<long>());
+                    prev_nonterm = value_node(term->token());
                     applied_rule = "number";
                     goto value_merge;
-
+                
                 case TokenType::decimal:
                     // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
-                    prev_nonterm = new ADLDecimal(term->debug(), term->value<double>());
+                    prev_nonterm = value_node(term->token());
                     applied_rule = "decimal";
                     goto value_merge;
                 
                 case TokenType::boolean:
                     // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
-                    prev_nonterm = new ADLBoolean(term->debug(), term->value<bool>());
+                    prev_nonterm = value_node(term->token());
                     applied_rule = "boolean";
                     goto value_merge;
                 
                 case TokenType::reference:
-                    {
-                        // First, split the reference into identifier & property
-                        size_t string_pos = 0;
-                        for (size_t i = 0; i < term->raw().size(); i++) { if (term->raw()[i] == '.') { string_pos = i; break; } }
-                        std::string identifier = term->raw().substr(0, string_pos);
-                        std::string property = term->raw().substr(string_pos + 1);
-
-                        // Infer the type of the reference
-                        IdentifierType reference_type = IdentifierType::positional;
-                        if (identifier == "meta") {
-                            // Meta
-                            reference_type = IdentifierType::meta;
-                        } else if (identifier[0] == '-' && identifier[1] == '-') {
-                            // Longlabel
-                            reference_type = IdentifierType::longlabel;
-                        } else if (identifier[0] == '-') {
-                            // Shortlabel
-                            reference_type = IdentifierType::shortlabel;
-                        } else if (identifier[0] == '<') {
-                            // Type
-                            reference_type = IdentifierType::type;
-                        }
-
-                        // With that over, create new debug info's for the two identifiers we'll use
-                        DebugInfo didentifier = term->debug();
-                        DebugInfo dproperty = term->debug();
-                        didentifier.col2 = string_pos - 1;
-                        dproperty.col1 = string_pos + 1;
-
-                        // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
-                        prev_nonterm = new ADLReference(term->debug(), new ADLIdentifier(didentifier, identifier, reference_type), new ADLIdentifier(dproperty, property, IdentifierType::property));
-                        applied_rule = "reference";
-                        goto value_merge;
-                    }
-
+                    // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
+                    prev_nonterm = value_node(term->token());
+                    applied_rule = "reference";
+                    goto value_merge;
+                
                 case TokenType::snippet:
                     // Store the non-terminal equivalent of this terminal as the previous symbol, and then move to the next state
-                    prev_nonterm = new ADLSnippet(term->debug(), term->raw());
+                    prev_nonterm = value_node(term->token());
                     applied_rule = "snippet";
                     goto value_merge;
                 
@@ -240,8 +315,9 @@ definition_start:
                     return "";
                 
                 default:
-                    // In every other case, we assume there to be a missing left curly
-                    Exceptions::log(Exceptions::MissingLCurlyError(DebugInfo(term->debug().filenames, term->debug().line2, term->debug().col2 + 1, term->debug().raw_line)));
+                    // In every other case, we assume there to be a missing left curly (before the right curly if that's the first thing in the file)
+                    if (term->type() == TokenType::empty) { Exceptions::log(Exceptions::MissingLCurlyError(prev_term->debug)); }
+                    else { Exceptions::log(Exceptions::MissingLCurlyError(DebugInfo(term->debug().filenames, term->debug().line2, term->debug().col2 + 1))); }
                     stack.remove(n_symbols);
                     return "";
 
@@ -256,13 +332,13 @@ definition_start:
                 
                 case NodeType::values:
                     // Missing semicolon
-                    Exceptions::log(Exceptions::MissingSemicolonError(DebugInfo(nterm->debug().filenames, nterm->debug().line2, nterm->debug().col2 + 1, nterm->debug().raw_line)));
+                    Exceptions::log(Exceptions::MissingSemicolonError(DebugInfo(nterm->debug().filenames, nterm->debug().line2, nterm->debug().col2 + 1)));
                     stack.remove(n_symbols);
                     return "";
 
                 default:
                     // In every other case, we assume there to be a missing left curly
-                    Exceptions::log(Exceptions::MissingLCurlyError(DebugInfo(nterm->debug().filenames, nterm->debug().line2, nterm->debug().col2 + 1, nterm->debug().raw_line)));
+                    Exceptions::log(Exceptions::MissingLCurlyError(DebugInfo(nterm->debug().filenames, nterm->debug().line2, nterm->debug().col2 + 1)));
                     stack.remove(n_symbols);
                     return "";
 
@@ -294,8 +370,8 @@ definition_configs:
                     return "";
                 
                 default:
-                    // Read the debug info from the terminal to error
-                    debug = term->debug();
+                    // Read the debug info from the terminal to error (or from the configs if they're the first thing in the file)
+                    debug = debug_or(term, prev_nonterm->debug);
 
             }
         } else {
@@ -340,7 +416,6 @@ definitions_body:
                         DebugInfo debug = term->debug();
                         debug.line2 = prev_term->debug.line2;
                         debug.col2 = prev_term->debug.col2;
-                        debug.raw_line = prev_term->debug.raw_line;
 
                         // Replace the symbols on the stack with the new definition
                         stack.replace(n_symbols, new NonTerminal(
@@ -356,7 +431,6 @@ definitions_body:
                         DebugInfo debug = term->debug();
                         debug.line2 = prev_term->debug.line2;
                         debug.col2 = prev_term->debug.col2;
-                        debug.raw_line = prev_term->debug.raw_line;
 
                         // Replace the symbols on the stack with the new definition
                         stack.replace(n_symbols, new NonTerminal(
@@ -425,9 +499,10 @@ definitions_variadic:
         DebugInfo debug = di_empty;
 
         // We now only accept an ADLTypes token
-        NonTerminal* nterm = (NonTerminal*) symbol;
+        NonTerminal* nterm = !symbol->is_terminal ? (NonTerminal*) symbol : nullptr;
         if (symbol->is_terminal) {
-            debug = ((Terminal*) symbol)->debug();
+            // Point at the body of the definition if the dots are the first thing in the file
+            debug = debug_or((Terminal*) symbol, prev_term->debug);
 
         } else {
             if (nterm->type() == NodeType::types) {
@@ -460,7 +535,7 @@ definitions_option:
         DebugInfo debug = prev_prev_term->debug;
 
         // Determine if we're going to use this next symbol or not
-        Terminal* term = (Terminal*) symbol;
+        Terminal* term = symbol->is_terminal ? (Terminal*) symbol : nullptr;
         if (prev_term->type == TokenType::shortlabel) {
             shortlabel = new ADLIdentifier(prev_term->debug, prev_term->raw, IdentifierType::shortlabel);
             if (symbol->is_terminal && term->type() == TokenType::longlabel) {
@@ -511,7 +586,6 @@ definitions_types:
                         DebugInfo debug = term->debug();
                         debug.line2 = prev_term->debug.line2;
                         debug.col2 = prev_term->debug.col2;
-                        debug.raw_line = prev_term->debug.raw_line;
 
                         // Apply the grammar rule!
                         stack.replace(n_symbols, new NonTerminal(
@@ -579,7 +653,6 @@ definitions_types_optional:
                         DebugInfo debug = term->debug();
                         debug.line2 = prev_term->debug.line2;
                         debug.col2 = prev_term->debug.col2;
-                        debug.raw_line = prev_term->debug.raw_line;
 
                         // Apply the grammar rule!
                         stack.replace(n_symbols, new NonTerminal(
@@ -696,7 +769,7 @@ definitions_optional_option:
         DebugInfo debug = prev_prev_term->debug;
 
         // Determine if we're going to use this next symbol or not
-        Terminal* term = (Terminal*) symbol;
+        Terminal* term = symbol->is_terminal ? (Terminal*) symbol : nullptr;
         if (prev_term->type == TokenType::shortlabel) {
             shortlabel = new ADLIdentifier(prev_term->debug, prev_term->raw, IdentifierType::shortlabel);
             if (symbol->is_terminal && term->type() == TokenType::longlabel) {
@@ -730,6 +803,9 @@ definitions_optional_option:
             else { debug = ((NonTerminal*) symbol)->debug(); }
             Exceptions::log(Exceptions::MissingLSquareError(debug));
             stack.remove(n_symbols);
+            // The labels never made it into an option, so free them ourselves
+            delete shortlabel;
+            delete longlabel;
             return "";
         }
 
@@ -752,9 +828,10 @@ definitions_optional_variadic:
         DebugInfo debug = di_empty;
 
         // We now only accept an ADLTypes token
-        NonTerminal* nterm = (NonTerminal*) symbol;
+        NonTerminal* nterm = !symbol->is_terminal ? (NonTerminal*) symbol : nullptr;
         if (symbol->is_terminal) {
-            debug = ((Terminal*) symbol)->debug();
+            // Point at the body of the definition if the dots are the first thing in the file
+            debug = debug_or((Terminal*) symbol, prev_term->debug);
 
         } else {
             if (nterm->type() == NodeType::types) {
@@ -784,14 +861,14 @@ definitions_optional_types:
         DebugInfo debug = di_empty;
 
         // We now only accept a closing bracket
-        Terminal* term = (Terminal*) symbol;
+        Terminal* term = symbol->is_terminal ? (Terminal*) symbol : nullptr;
         if (symbol->is_terminal) {
             if (term->type() == TokenType::l_square) {
                 // Sweet! Go on to a special state which only allows parsing of Options, after marking the type as optional
                 types_optional = true;
                 goto definitions_types_options;
             } else {
-                debug = term->debug();
+                debug = debug_or(term, prev_nonterm->debug);
             }
         } else {
             debug = ((NonTerminal*) symbol)->debug();
@@ -901,10 +978,10 @@ config_start:
                 case TokenType::l_curly:
                 case TokenType::semicolon:
                     // Simply an empty statement; we'll allow it (but with warning)
-                    Exceptions::log(Exceptions::EmptyStatementWarning(prev_term->debug));
+                    Exceptions::warn<Exceptions::EmptyStatementWarning>(prev_term->debug);
+                    // Close the config level suppressions at the semicolon
+                    Exceptions::SuppressionList::current().close(Exceptions::SuppressionScope::config, prev_term->debug);
                     stack.remove(1);
-                    // Clear the config level suppressed warnings
-                    Exceptions::error_handler.clear_config();
                     return "";
                 
                 case TokenType::config:
@@ -914,11 +991,11 @@ config_start:
                     return "";
                 
                 default:
-                    // Unexpected symbol to follow a termination; let the user know
-                    Exceptions::log(Exceptions::StraySemicolonWarning(term->debug()));
+                    // Unexpected symbol to follow a termination; let the user know (pointing at the semicolon itself if it's the first thing in the file)
+                    Exceptions::warn<Exceptions::StraySemicolonWarning>(term->type() == TokenType::empty ? prev_term->debug : term->debug());
+                    // Close the config level suppressions at the semicolon
+                    Exceptions::SuppressionList::current().close(Exceptions::SuppressionScope::config, prev_term->debug);
                     stack.remove(1);
-                    // Clear the config level suppressed warnings
-                    Exceptions::error_handler.clear_config();
                     return "";
 
             }
@@ -932,10 +1009,10 @@ config_start:
                 
                 default:
                     // Unexpected symbol to follow a termination; let the user know
-                    Exceptions::log(Exceptions::StraySemicolonWarning(nterm->debug()));
+                    Exceptions::warn<Exceptions::StraySemicolonWarning>(nterm->debug());
+                    // Close the config level suppressions at the semicolon
+                    Exceptions::SuppressionList::current().close(Exceptions::SuppressionScope::config, prev_term->debug);
                     stack.remove(1);
-                    // Clear the config level suppressed warnings
-                    Exceptions::error_handler.clear_config();
                     return "";
 
             }
@@ -950,7 +1027,7 @@ config_values:
         PEEK(symbol, iter, n_symbols);
 
         // Do different things based on whether it is a terminal or not
-        Terminal* term = (Terminal*) symbol;
+        Terminal* term = symbol->is_terminal ? (Terminal*) symbol : nullptr;
         if (symbol->is_terminal && term->type() == TokenType::config) {
             // If it's a configuration identifier, that must be the keyword, and thus we're done
 
@@ -970,10 +1047,10 @@ config_values:
         debug.col2 = prev_term->debug.col2;
         Exceptions::log(Exceptions::MissingConfigError(debug));
 
+        // Close the config level suppressions at the semicolon
+        Exceptions::SuppressionList::current().close(Exceptions::SuppressionScope::config, prev_term->debug);
         // Also remove the two symbols from the stack, for the simple reason as to not infuriate later errors
         stack.remove(2);
-        // Clear the config level suppressed warnings
-        Exceptions::error_handler.clear_config();
         return "";
     }
 
@@ -1007,12 +1084,8 @@ modifier_identifier:
                             return "";
                         }
 
-                        // Add the warning to the list of suppressed warnings, depending on if we're in the toplevel or not
-                        if (state.toplevel) {
-                            Exceptions::error_handler.toplevel_suppressed = Exceptions::error_handler.toplevel_suppressed | warning;
-                        } else {
-                            Exceptions::error_handler.config_suppressed = Exceptions::error_handler.config_suppressed | warning;
-                        }
+                        // Suppress the warning from here until the end of the definition or config that follows, depending on if we're in the toplevel or not
+                        Exceptions::SuppressionList::current().suppress(state.toplevel ? Exceptions::SuppressionScope::toplevel : Exceptions::SuppressionScope::config, term->debug(), warning);
 
                         // Replace it with a suppress-node and we're done (for now)
                         stack.remove(2);
@@ -1065,7 +1138,7 @@ modifier_string:
         PEEK(symbol, iter, n_symbols);
 
         // If it's a suppress or warning token, then we parse it as such
-        NonTerminal* nterm = (NonTerminal*) symbol;
+        NonTerminal* nterm = !symbol->is_terminal ? (NonTerminal*) symbol : nullptr;
         if (symbol->is_terminal) {
             Terminal* term = (Terminal*) symbol;
             switch(term->type()) {
@@ -1080,6 +1153,7 @@ modifier_string:
                         // Throw the error with the new DebugInfo, removing both the id and error from the stack
                         Exceptions::log(Exceptions::SuppressStringError(debug));
                         stack.remove(2);
+                        delete prev_nonterm;
                         return "";
                     }
 
@@ -1092,7 +1166,7 @@ modifier_string:
                         debug.col2 = prev_nonterm->debug.col2;
 
                         // Throw it
-                        Exceptions::log(Exceptions::CustomWarning(debug, ((ADLString*) prev_nonterm)->value));
+                        Exceptions::warn<Exceptions::CustomWarning>(debug, ((ADLString*) prev_nonterm)->value);
 
                         // Remove the string and the warning from the stack, as their usefullness is over
                         stack.remove(2);
@@ -1154,8 +1228,8 @@ types_merge:
         PEEK(symbol, iter, temp);
 
         // Do different things based on whether it is a terminal or not
-        Terminal* term = (Terminal*) symbol;
-        NonTerminal* nterm = (NonTerminal*) symbol;
+        Terminal* term = symbol->is_terminal ? (Terminal*) symbol : nullptr;
+        NonTerminal* nterm = !symbol->is_terminal ? (NonTerminal*) symbol : nullptr;
         if (symbol->is_terminal && (term->type() == TokenType::identifier ||
                                     term->type() == TokenType::shortlabel ||
                                     term->type() == TokenType::longlabel ||
@@ -1167,7 +1241,7 @@ types_merge:
             ));
             return "types-new";
 
-        } else if (nterm->type() == NodeType::types) {
+        } else if (!symbol->is_terminal && nterm->type() == NodeType::types) {
             // Merge it with the previous types list
             nterm->node<ADLTypes>()->add_node(new ADLIdentifier(prev_term->debug, prev_term->raw, IdentifierType::type));
 
@@ -1193,8 +1267,8 @@ config_merge:
         int temp = 0;
         PEEK(symbol, iter, temp);
 
-        // Always clear the config surpressed tokens
-        Exceptions::error_handler.clear_config();
+        // The config level suppressions end where the config does
+        Exceptions::SuppressionList::current().close(Exceptions::SuppressionScope::config, prev_nonterm->debug);
 
         // Do different things based on whether it is a configs node or not
         if (!symbol->is_terminal) {
@@ -1207,7 +1281,6 @@ config_merge:
                     // Update the value's debug info though
                     nterm->node<ADLConfigs>()->debug.line2 = prev_nonterm->debug.line2;
                     nterm->node<ADLConfigs>()->debug.col2 = prev_nonterm->debug.col2;
-                    nterm->node<ADLConfigs>()->debug.raw_line = prev_nonterm->debug.raw_line;
 
                     // Remove the merged nonterms
                     stack.remove(n_symbols);
@@ -1218,6 +1291,8 @@ config_merge:
                     // Probably a missing semicolon
                     Exceptions::log(Exceptions::MissingSemicolonError(nterm->debug()));
                     stack.remove(n_symbols);
+                    // The config isn't on the stack, so free it (and the values it adopted) ourselves
+                    delete prev_nonterm;
                     return "";
                 
                 default:
@@ -1242,7 +1317,7 @@ value_merge:
         PEEK(symbol, iter, temp);
 
         // Do different things based on whether it is a terminal or not
-        NonTerminal* nterm = (NonTerminal*) symbol;
+        NonTerminal* nterm = !symbol->is_terminal ? (NonTerminal*) symbol : nullptr;
         if (!symbol->is_terminal && nterm->type() == NodeType::values) {
             // Merge this value to the previously found Values
             nterm->node<ADLValues>()->add_node(prev_nonterm);
@@ -1272,11 +1347,11 @@ toplevel_merge:
         int temp = 0;
         PEEK(symbol, iter, temp);
 
-        // Always clear the toplevel surpressed tokens
-        Exceptions::error_handler.clear_toplevel();
+        // The toplevel suppressions end where the definition does
+        Exceptions::SuppressionList::current().close(Exceptions::SuppressionScope::toplevel, prev_nonterm->debug);
 
         // Do different things based on whether it is a terminal or not
-        NonTerminal* nterm = (NonTerminal*) symbol;
+        NonTerminal* nterm = !symbol->is_terminal ? (NonTerminal*) symbol : nullptr;
         if (!symbol->is_terminal && nterm->type() == NodeType::root) {
             // Merge this value to the previously found File node
             nterm->node<ADLTree>()->add_node(prev_nonterm);
@@ -1284,7 +1359,6 @@ toplevel_merge:
             // Update the Tree's debug information
             nterm->node<ADLTree>()->debug.line2 = prev_nonterm->debug.line2;
             nterm->node<ADLTree>()->debug.col2 = prev_nonterm->debug.col2;
-            nterm->node<ADLTree>()->debug.raw_line = prev_nonterm->debug.raw_line;
 
             // We're done here
             stack.remove(n_symbols);
@@ -1351,16 +1425,56 @@ start:
     }
 }
 
+/* Traversal function that collects the identifiers of all definitions referenced by the types and references it's called on. */
+static ADLNode* collect_references(const char*, ADLNode* node, void* vreferenced) {
+    std::unordered_set<intern_t>* referenced = (std::unordered_set<intern_t>*) vreferenced;
 
+    // Either store all type identifiers or the identifier of the referenced definition
+    if (node->type == NodeType::types) {
+        ADLTypes* types = (ADLTypes*) node;
+        for (size_t i = 0; i < types->size(); i++) {
+            referenced->insert(types->get_node<ADLIdentifier>(i)->id);
+        }
+    } else {
+        referenced->insert(((ADLReference*) node)->definition->id);
+    }
 
+    // We won't change any nodes
+    return node;
+}
 
+/* Returns whether the given definition may be referenced by others, i.e., if it is a type or meta definition or if any of the definition's identifiers is in the given set of referenced identifiers. */
+static bool is_referenced(ADLDefinition* definition, const std::unordered_set<intern_t>& referenced) {
+    return
+        definition->type == NodeType::type_def || definition->type == NodeType::meta ||
+        (definition->identifier != nullptr && referenced.count(definition->identifier->id) > 0) ||
+        (definition->shortlabel != nullptr && referenced.count(definition->shortlabel->id) > 0) ||
+        (definition->longlabel != nullptr && referenced.count(definition->longlabel->id) > 0)
+    ;
+}
 
-/***** PARSER CLASS *****/
+/* Lets the given tree retain the files the given preprocessor opened, so their contents outlive the preprocessor. */
+static void retain_sources(ADLTree* tree, const Preprocessor& in) {
+    tree->sources = in.sources();
+    for (size_t i = 0; i < tree->sources.size(); i++) {
+        source_manager.retain(tree->sources[i]);
+    }
+}
+
+/* Does the actual parsing for the parse() overloads. If the statistics aren't a nullptr, they are filled with the number of shifts & reductions done. If the callback isn't a nullptr, it is called for each completed toplevel definition before it is merged into the tree. If the opener isn't a nullptr, the preprocessor opens files with it instead of reading them from disk. */
+static ADLTree* parse_file(const std::string& filename, ParseStatistics* statistics, definition_callback callback, void* cstate, file_opener opener, void* ostate) {
+    // Allocate the nodes in one arena, unless definitions may be released halfway through (in which case their memory should go too)
+    std::shared_ptr<ADLArena> arena = callback == nullptr ? std::make_shared<ADLArena>() : nullptr;
+    ADLArena::Scope scope(arena.get());
+    // Intern the identifiers of this compilation in a table of its own
+    std::shared_ptr<InternTable> interns = std::make_shared<InternTable>();
+    InternTable::Scope intern_scope(interns.get());
+    // Record where warnings are suppressed in a list of its own as well
+    std::shared_ptr<Exceptions::SuppressionList> suppressions = std::make_shared<Exceptions::SuppressionList>();
+    Exceptions::SuppressionList::Scope suppression_scope(suppressions.get());
 
-/* Parses a single file. Returns a single root node, from which the entire parsed tree is build. Does not immediately throw exceptions, but collects them in a vector which is then thrown. Use std::print_error on each of them to print them neatly. Warnings are always printed by the function, never thrown. */
-ADLTree* ArgumentParser::Parser::parse(const std::string& filename) {
     // Let's create a Tokenizer for our file
-    Preprocessor in(filename, {});
+    Preprocessor in(filename, {}, opener, ostate);
 
     // Initialize the stack
     SymbolStack stack;
@@ -1370,19 +1484,45 @@ ADLTree* ArgumentParser::Parser::parse(const std::string& filename) {
 
     // Prepare the value that's used to keep track of all the possible WarningTypes that are suppressed currently
     ParseState state({ true });
+    // Keeps track of the identifiers referenced by definitions that were already handed to the callback
+    std::unordered_set<intern_t> referenced;
+    // Start counting from zero if we're asked to count
+    if (statistics != nullptr) { *statistics = { 0, 0 }; }
 
     // Parse as a shift-reduce parser - in every iteration, fetch a token and attempt to reduce the stack of tokens to a tree of nodes
     Token* lookahead = in.pop();
     bool changed = true;
     while (!in.eof() || changed) {
-        // Check to see if we can match any grammar rule (reduce)
-        std::string applied_rule = reduce(state, filename, lookahead, stack);
+        // Give up as soon as too many errors have been logged
+        if (Exceptions::ExceptionHandler::current().exhausted()) { break; }
+
+        // Check to see if we can parse a run of values or match any grammar rule (reduce)
+        std::string applied_rule = parse_values(in, lookahead, stack);
+        if (applied_rule.empty()) { applied_rule = reduce(state, filename, lookahead, stack); }
         changed = !applied_rule.empty();
+        if (statistics != nullptr && changed) { ++statistics->reductions; }
+
+        // If we just completed a toplevel definition, hand it to the callback before it's merged
+        Symbol* top = *stack.begin();
+        if (callback != nullptr && changed && !top->is_terminal && (((NonTerminal*) top)->type() & nt_toplevel)) {
+            ADLDefinition* definition = ((NonTerminal*) top)->node<ADLDefinition>();
+            definition->traverse("parse_stream", NodeType::types | NodeType::reference, collect_references, (void*) &referenced);
+
+            // Release it if we're allowed to and nobody needs it
+            if (callback(definition, cstate) && !is_referenced(definition, referenced)) {
+                // Since it won't be merged, end the toplevel suppressions at it ourselves
+                suppressions->close(Exceptions::SuppressionScope::toplevel, definition->debug);
+
+                // Removing it from the stack frees it, since nothing adopted it
+                stack.remove(1);
+            }
+        }
 
         // If we couldn't, then shift a new symbol if there are any left
         if (applied_rule.empty() && lookahead->type != TokenType::empty) {
             stack.add_terminal(lookahead);
             lookahead = in.pop();
+            if (statistics != nullptr) { ++statistics->shifts; }
 
             // Mark that the stack still changed
             changed = true;
@@ -1402,22 +1542,114 @@ ADLTree* ArgumentParser::Parser::parse(const std::string& filename) {
     cout << endl;
     #endif
 
+    // If the file had no definitions or all of them were released, return an empty tree
+    bool exhausted = Exceptions::ExceptionHandler::current().exhausted();
+    if (stack.size() == 0 && !exhausted) {
+        ADLTree* tree = new ADLTree(filename);
+        tree->arena = arena;
+        tree->interns = interns;
+        tree->suppressions = suppressions;
+        retain_sources(tree, in);
+        return tree;
+    }
+
     // Check if we parsed everything
-    if (stack.size() != 1 || stack[0]->is_terminal || ((NonTerminal*) stack[0])->type() != NodeType::root) {
-        // Print errors to the user
-        analyze_errors(stack);
-
-        // Free the stack
-        for (size_t i = 0; i < stack.size(); i++) {
-            if (!stack[i]->is_terminal) {
-                delete ((NonTerminal*) stack[i])->node();
-            }
-        }
+    if (exhausted || stack.size() != 1 || stack[0]->is_terminal || ((NonTerminal*) stack[0])->type() != NodeType::root) {
+        // Print errors to the user, unless we already have more than we may store
+        if (!exhausted) { analyze_errors(stack); }
 
-        // Return that we failed
+        // Return that we failed; the stack frees the nodes left on it
         return nullptr;
     }
 
-    // If we were successfull, return the only symbol as ADLFile!
-    return ((NonTerminal*) stack[0])->node<ADLTree>();
+    // If we were successfull, take the only symbol off the stack without freeing it, let the tree keep its nodes' memory alive and return it as ADLFile!
+    ADLTree* tree = ((NonTerminal*) stack[0])->node<ADLTree>();
+    ((NonTerminal*) stack[0])->node() = nullptr;
+    tree->arena = arena;
+    tree->interns = interns;
+    tree->suppressions = suppressions;
+    retain_sources(tree, in);
+    return tree;
+}
+
+
+
+
+
+/***** PARSER CLASS *****/
+
+/* Parses a single file. Returns a single root node, from which the entire parsed tree is build. Does not immediately throw exceptions, but collects them in a vector which is then thrown. Use std::print_error on each of them to print them neatly. Warnings are always printed by the function, never thrown. If statistics is given, it is filled with the number of shifts & reductions done. */
+ADLTree* ArgumentParser::Parser::parse(const std::string& filename, ParseStatistics* statistics) {
+    return parse_file(filename, statistics, nullptr, nullptr, nullptr, nullptr);
+}
+
+/* Parses a single file in a streaming fashion, calling the given callback (with the given state) as soon as each toplevel definition is reduced. Positionals and Options the callback releases are deallocated immediately, unless a previously emitted definition references them; types and metas are always kept, since they are what other definitions typically reference. Note that references to released arguments from definitions later in the file will thus not resolve. Returns a tree with only the definitions that were kept (which may thus be empty), or a nullptr if parsing failed. */
+ADLTree* ArgumentParser::Parser::parse(const std::string& filename, definition_callback callback, void* state) {
+    return parse_file(filename, nullptr, callback, state, nullptr, nullptr);
+}
+
+/* Parses a single file like the first overload does, except that the root file and all files it includes are opened with the given callback (and its state) instead of read from disk. */
+ADLTree* ArgumentParser::Parser::parse(const std::string& filename, file_opener opener, void* state) {
+    return parse_file(filename, nullptr, nullptr, nullptr, opener, state);
+}
+
+/* Parses a single toplevel definition from the given Tokenizer, which should be positioned at the start of that definition. Stops as soon as one definition has been reduced, and returns it (or a nullptr if the tokens didn't form exactly one definition). Does not run the preprocessor, so any macro encountered also results in a nullptr. */
+ADLDefinition* ArgumentParser::Parser::parse_definition(Tokenizer& in, const std::string& filename) {
+    // Initialize the stack & the state
+    SymbolStack stack;
+    ParseState state({ true });
+
+    // Remember how many errors we had before, so we can tell if the definition itself was faulty
+    size_t n_errors = Exceptions::ExceptionHandler::current().errors();
+
+    // Parse as a shift-reduce parser again, except that we stop as soon as the stack is a single definition
+    ADLDefinition* result = nullptr;
+    Token* lookahead = in.pop();
+    bool changed = true;
+    while (!in.eof() || changed) {
+        // Give up as soon as too many errors have been logged
+        if (Exceptions::ExceptionHandler::current().exhausted()) { break; }
+
+        // If the stack has been reduced to one toplevel definition, we're done
+        if (stack.size() == 1 && !stack[0]->is_terminal && (((NonTerminal*) stack[0])->type() & nt_toplevel)) {
+            result = ((NonTerminal*) stack[0])->node<ADLDefinition>();
+            break;
+        }
+        // Macros are the preprocessor's business, which we do not run here
+        if (lookahead->type == TokenType::macro) { break; }
+
+        // Check to see if we can parse a run of values or match any grammar rule (reduce)
+        std::string applied_rule = parse_values(in, lookahead, stack);
+        if (applied_rule.empty()) { applied_rule = reduce(state, filename, lookahead, stack); }
+        changed = !applied_rule.empty();
+
+        // If we couldn't, then shift a new symbol if there are any left
+        if (applied_rule.empty() && lookahead->type != TokenType::empty) {
+            stack.add_terminal(lookahead);
+            lookahead = in.pop();
+            changed = true;
+        }
+
+        #ifdef DEBUG
+        cout << "[   ADLParser   ] " << (!applied_rule.empty() ? "Reduce : " : "Shift  : ") << stack;
+        if (!applied_rule.empty()) { cout << " // " << applied_rule; }
+        cout << endl;
+        #endif
+    }
+    // The definition may also have been the last thing in the file
+    if (result == nullptr && stack.size() == 1 && !stack[0]->is_terminal && (((NonTerminal*) stack[0])->type() & nt_toplevel)) {
+        result = ((NonTerminal*) stack[0])->node<ADLDefinition>();
+    }
+    delete lookahead;
+
+    // Only accept the result if the parsing went error-free
+    if (result != nullptr && Exceptions::ExceptionHandler::current().errors() == n_errors) {
+        // Take it off the stack without deallocating the node, and return
+        ((NonTerminal*) stack[0])->node() = nullptr;
+        stack.remove(1);
+        return result;
+    }
+
+    // Otherwise, return that we failed; the stack frees whatever nodes are left on it
+    return nullptr;
 }
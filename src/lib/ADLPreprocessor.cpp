@@ -4,7 +4,7 @@
  * Created:
  *   03/12/2020, 21:52:46
  * Last edited:
- *   01/01/2021, 14:39:46
+ *   18/10/2026, 19:43:52
  * Auto updated?
  *   Yes
  *
@@ -38,8 +38,10 @@ using namespace ArgumentParser;
 
 /***** ADLPreprocessor CLASS *****/
 
-/* Constructor for the Preprocessor class, which takes a filename to open and a vector containing all the defines from the CLI. */
-Preprocessor::Preprocessor(const std::string& filename, const std::vector<std::string>& defines) :
+/* Constructor for the Preprocessor class, which takes a filename to open, a vector containing all the defines from the CLI and optionally a callback (with its state) to open the files with instead of reading them from disk. */
+Preprocessor::Preprocessor(const std::string& filename, const std::vector<std::string>& defines, file_opener opener, void* opener_state) :
+    opener(opener),
+    opener_state(opener_state),
     length(1),
     max_length(1),
     done_tokenizing(false),
@@ -50,18 +52,22 @@ Preprocessor::Preprocessor(const std::string& filename, const std::vector<std::s
     this->tokenizers = new Tokenizer*[this->max_length];
 
     // Create a new Tokenizer for the first file
-    this->tokenizers[0] = new Tokenizer(new ifstream(filename), { filename });
+    this->tokenizers[0] = new Tokenizer(this->open(filename), { filename });
     this->current = this->tokenizers[0];
+    this->retain(this->current);
 }
 
 /* Move constructor for the Preprocessor class. */
 Preprocessor::Preprocessor(Preprocessor&& other) :
+    opener(other.opener),
+    opener_state(other.opener_state),
     current(other.current),
     tokenizers(other.tokenizers),
     length(other.length),
     max_length(other.max_length),
     done_tokenizing(other.done_tokenizing),
     included_paths(other.included_paths),
+    files(std::move(other.files)),
     defines(other.defines),
     ifdefs(other.ifdefs),
     ifdefs_stack(other.ifdefs_stack)
@@ -79,10 +85,21 @@ Preprocessor::~Preprocessor() {
         }
         delete[] this->tokenizers;
     }
+
+    // Let the source manager know we no longer need the files' contents
+    for (size_t i = 0; i < this->files.size(); i++) {
+        source_manager.release(this->files[i]);
+    }
 }
 
 
 
+/* Opens the file at the given path with the opener, or from disk if there is none. */
+std::istream* Preprocessor::open(const std::string& path) {
+    if (this->opener == nullptr) { return new ifstream(path); }
+    return this->opener(path, this->opener_state);
+}
+
 /* Handler for the include-macro. */
 Token* Preprocessor::include_handler(bool pop, Token* token) {
     // Get the next token (always pop, since it'll be a relevant value)
@@ -96,12 +113,17 @@ Token* Preprocessor::include_handler(bool pop, Token* token) {
         cout << "[ADLPreprocessor] Including local file '" << token->raw << "'" << endl;
         #endif
 
+        // We only need the path from the token, so free it already in case opening the file throws
+        std::string path = token->raw;
+        delete token;
+
         // Only add a new tokenizer if we never seen it before
-        if (!this->contains(this->included_paths, token->raw)) {
+        if (!this->contains(this->included_paths, path)) {
             // Try to open a Tokenizer at the given path
             std::vector<std::string> new_filenames = this->current->filenames;
-            new_filenames.push_back(token->raw);
-            Tokenizer* new_tokenizer = new Tokenizer(new ifstream(token->raw), new_filenames);
+            new_filenames.push_back(path);
+            Tokenizer* new_tokenizer = new Tokenizer(this->open(path), new_filenames);
+            this->retain(new_tokenizer);
 
             // Set it as the current tokenizer & add to the list
             this->current = new_tokenizer;
@@ -113,16 +135,15 @@ Token* Preprocessor::include_handler(bool pop, Token* token) {
             this->ifdefs.clear();
 
             // Don't forget to add the new path to the list of included paths
-            this->included_paths.push_back(token->raw);
+            this->included_paths.push_back(path);
         }
         #ifdef DEBUG
         else {
-            cout << "[ADLPreprocessor]  > No need, '" << token->raw << "' already included" << endl;
+            cout << "[ADLPreprocessor]  > No need, '" << path << "' already included" << endl;
         }
         #endif
 
         // Use recursion to return the first token in that tokenizer
-        delete token;
         return this->read_head(pop);
 
     } else if (token->type == TokenType::identifier) {
@@ -149,6 +170,7 @@ Token* Preprocessor::include_handler(bool pop, Token* token) {
                 // Not found; throw an error that it was an illegal system file
                 Exceptions::log(Exceptions::IllegalSysFileException(token->debug, token->raw, sstr.str()));
                 // Use recursion to find the next token instead
+                delete token;
                 return this->read_head(pop);
             }
             
@@ -156,6 +178,7 @@ Token* Preprocessor::include_handler(bool pop, Token* token) {
             std::vector<std::string> new_filenames = this->current->filenames;
             new_filenames.push_back(token->raw);
             Tokenizer* new_tokenizer = new Tokenizer(new stringstream(System::files[index]), new_filenames);
+            this->retain(new_tokenizer);
 
             // Set it as the current tokenizer & add to the list
             this->current = new_tokenizer;
@@ -182,6 +205,7 @@ Token* Preprocessor::include_handler(bool pop, Token* token) {
     } else {
         Exceptions::log(Exceptions::IllegalMacroValueException(token->debug, "include", tokentype_names[(int) token->type], "string or build-in identifier"));
         // Use recursion to find the next token instead
+        delete token;
         return this->read_head(pop);
     }
 }
@@ -195,6 +219,7 @@ Token* Preprocessor::define_handler(bool pop, Token* token) {
     if (token->type != TokenType::identifier) {
         Exceptions::log(Exceptions::IllegalMacroValueException(token->debug, "define", tokentype_names[(int) token->type], "define identifier"));
         // Use recursion to find the next token instead
+        delete token;
         return this->read_head(pop);
     }
 
@@ -204,7 +229,7 @@ Token* Preprocessor::define_handler(bool pop, Token* token) {
 
     // Check if we already included this one
     if (this->contains(this->defines, token->raw)) {
-        Exceptions::log(Exceptions::DuplicateDefineWarning(token->debug, token->raw));
+        Exceptions::warn<Exceptions::DuplicateDefineWarning>(token->debug, token->raw);
     } else {
         // Add it to the internal list
         this->defines.push_back(token->raw);
@@ -224,6 +249,7 @@ Token* Preprocessor::undefine_handler(bool pop, Token* token) {
     if (token->type != TokenType::identifier) {
         Exceptions::log(Exceptions::IllegalMacroValueException(token->debug, "undefine", tokentype_names[(int) token->type], "define identifier"));
         // Use recursion to find the next token instead
+        delete token;
         return this->read_head(pop);
     }
 
@@ -234,7 +260,7 @@ Token* Preprocessor::undefine_handler(bool pop, Token* token) {
     // Check if we can remove this one
     size_t index;
     if (!this->contains(index, this->defines, token->raw)) {
-        Exceptions::log(Exceptions::MissingDefineWarning(token->debug, token->raw));
+        Exceptions::warn<Exceptions::MissingDefineWarning>(token->debug, token->raw);
     } else {
         // Remove it from the internal list
         for (size_t i = index; i < this->defines.size() - 1; i++) {
@@ -298,6 +324,7 @@ Token* Preprocessor::ifdef_handler(bool pop, Token* token) {
                 // Unclosed if-statement encountered!
                 Exceptions::log(Exceptions::UnmatchedIfdefException(debug));
                 // Use recursion to find the next token instead
+                delete token;
                 return this->read_head(pop);
             }
         }
@@ -326,6 +353,7 @@ Token* Preprocessor::ifndef_handler(bool pop, Token* token) {
     if (token->type != TokenType::identifier) {
         Exceptions::log(Exceptions::EmptyConditionException(token->debug, "ifdef"));
         // Use recursion to find the next token instead
+        delete token;
         return this->read_head(pop);
     }
 
@@ -361,6 +389,7 @@ Token* Preprocessor::ifndef_handler(bool pop, Token* token) {
                 // Unclosed if-statement encountered!
                 Exceptions::log(Exceptions::UnmatchedIfndefException(debug));
                 // Use recursion to find the next token instead
+                delete token;
                 return this->read_head(pop);
             }
         }
@@ -384,6 +413,7 @@ Token* Preprocessor::endif_handler(bool pop, Token* token) {
         // We don't; unmatched endif
         Exceptions::log(Exceptions::UnmatchedEndifException(token->debug));
         // Use recursion to find the next token instead
+        delete token;
         return this->read_head(pop);
     }
 
@@ -416,6 +446,13 @@ void Preprocessor::resize() {
     this->tokenizers = new_tokenizers;
 } 
 
+/* Keeps the contents of the file read by the given (new) tokenizer around after the tokenizer is done with it. */
+void Preprocessor::retain(const Tokenizer* tokenizer) {
+    if (tokenizer->source == SourceManager::none) { return; }
+    source_manager.retain(tokenizer->source);
+    this->files.push_back(tokenizer->source);
+}
+
 /* Used internally to read the first token off the stream. */
 Token* Preprocessor::read_head(bool pop) {
     // Get a token from the Tokenizer
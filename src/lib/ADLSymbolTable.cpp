@@ -4,7 +4,7 @@
  * Created:
  *   10/12/2020, 14:44:57
  * Last edited:
- *   11/02/2021, 18:03:55
+ *   18/10/2026, 15:38:56
  * Auto updated?
  *   Yes
  *
@@ -24,21 +24,36 @@ using namespace ArgumentParser;
 
 
 /***** HELPER FUNCTIONS *****/
-/* Returns a raw version of the given ID, that is suitable for internal use within the SymbolTable. */
-static std::string get_raw(const std::string& id) {
+/* Returns a raw version of the given ID, that is suitable for internal use within the SymbolTable. The result refers to the given ID, so it's only valid for as long as that is. */
+static std::string_view get_raw(const std::string& id) {
     if (id == "meta") {
         return "[meta]";
     } else if (id.size() > 0 && id[0] == '-') {
         if (id.size() > 1 && id[1] == '-') {
-            return id.substr(2);
+            return std::string_view(id).substr(2);
         } else {
-            return id.substr(1);
+            return std::string_view(id).substr(1);
         }
     } else {
         return id;
     }
 }
 
+/* Returns the debug information of the identifier the given node is declared with, or that of the node itself if it's a property. Options are pointed to by their longlabel if they have one. */
+static const DebugInfo& declared_at(ADLNode* node) {
+    if (node->type == NodeType::config) { return node->debug; }
+    ADLDefinition* definition = (ADLDefinition*) node;
+    if (definition->identifier != nullptr) { return definition->identifier->debug; }
+    if (definition->longlabel != nullptr) { return definition->longlabel->debug; }
+    if (definition->shortlabel != nullptr) { return definition->shortlabel->debug; }
+    return node->debug;
+}
+
+/* Returns the hash of the given raw ID, as used in the SymbolTable's index. */
+static inline size_t hash_raw(const std::string_view& raw_id) {
+    return std::hash<std::string_view>()(raw_id);
+}
+
 
 
 
@@ -50,80 +65,97 @@ SymbolTable::SymbolTable() {}
 
 
 
+/* Adds the entry at the given position to the index, unless an earlier entry already has the same raw id. */
+void SymbolTable::index_entry(size_t i) {
+    if (this->lookup(this->entries[i].raw_id) < i) { return; }
+    this->index.insert({ hash_raw(this->entries[i].raw_id), i });
+}
+
+/* Rebuilds the index from scratch, which is needed after entries have moved. */
+void SymbolTable::reindex() {
+    this->index.clear();
+    for (size_t i = 0; i < this->entries.size(); i++) {
+        this->index_entry(i);
+    }
+}
+
+/* Returns the position of the first entry with the given raw id, or the size of the table if there is none. */
+size_t SymbolTable::lookup(const std::string_view& raw_id) const {
+    // Search the entries with the same hash for one that really matches
+    auto range = this->index.equal_range(hash_raw(raw_id));
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (this->entries[iter->second].raw_id == raw_id) { return iter->second; }
+    }
+
+    // Did not find it
+    return this->entries.size();
+}
+
+
+
 /* Tries to add a new symbol to the table. Throws a DuplicateSymbolError if it's already defined, unless it's a meta definition. */
 void SymbolTable::add(const std::string& id, ADLNode* node) {
     // Check if it already exists
-    string raw_id = get_raw(id);
-    for (std::vector<SymbolTableEntry>::const_iterator iter = this->entries.begin(); iter != this->entries.end(); ++iter) {
-        if ((*iter).raw_id == raw_id) {
-            // Switch based on the node's type
-            switch(node->type) {
-                case NodeType::meta:
-                    // This is allowed
-                    break;
-
-                case NodeType::positional:
-                case NodeType::option:
-                    // Throw an error that this node has a duplicate ID
-                    Exceptions::log(
-                        Exceptions::DuplicateArgumentError(
-                            ((ADLDefinition*) node)->identifier->debug,
-                            id
-                        ),
-                        Exceptions::DuplicateSymbolNote(((ADLDefinition*) (*iter).node)->identifier->debug)
-                    );
-                    return;
-
-                case NodeType::type_def:
-                    // Throw an error that this node has a duplicate ID
-                    Exceptions::log(
-                        Exceptions::DuplicateTypeError(
-                            ((ADLDefinition*) node)->identifier->debug,
-                            id
-                        ),
-                        Exceptions::DuplicateSymbolNote(((ADLDefinition*) (*iter).node)->identifier->debug)
-                    );
-                    return;
-
-                case NodeType::config:
-                    // Throw an error that this node has a duplicate ID
-                    Exceptions::log(
-                        Exceptions::DuplicatePropertyError(
-                            ((ADLDefinition*) node)->debug,
-                            id
-                        ),
-                        Exceptions::DuplicateSymbolNote(((ADLDefinition*) (*iter).node)->identifier->debug)
-                    );
-                    return;
-                    
-                default:
-                    // Sanity check failed
-                    throw std::runtime_error("Node with unexpected type '" + nodetype_name.at(node->type) + "' given to SymbolTable::add");
-            }
-            break;
+    std::string_view raw_id = get_raw(id);
+    size_t i = this->lookup(raw_id);
+    if (i < this->entries.size()) {
+        const SymbolTableEntry& existing = this->entries[i];
+
+        // Switch based on the node's type
+        switch(node->type) {
+            case NodeType::meta:
+                // This is allowed
+                break;
+
+            case NodeType::positional:
+            case NodeType::option:
+                // Throw an error that this node has a duplicate ID
+                Exceptions::log(
+                    Exceptions::DuplicateArgumentError(
+                        declared_at(node),
+                        id
+                    ),
+                    Exceptions::DuplicateSymbolNote(declared_at(existing.node))
+                );
+                return;
+
+            case NodeType::type_def:
+                // Throw an error that this node has a duplicate ID
+                Exceptions::log(
+                    Exceptions::DuplicateTypeError(
+                        declared_at(node),
+                        id
+                    ),
+                    Exceptions::DuplicateSymbolNote(declared_at(existing.node))
+                );
+                return;
+
+            case NodeType::config:
+                // Throw an error that this node has a duplicate ID
+                Exceptions::log(
+                    Exceptions::DuplicatePropertyError(
+                        declared_at(node),
+                        id
+                    ),
+                    Exceptions::DuplicateSymbolNote(declared_at(existing.node))
+                );
+                return;
+                
+            default:
+                // Sanity check failed
+                throw std::runtime_error("Node with unexpected type '" + nodetype_name.at(node->type) + "' given to SymbolTable::add");
         }
     }
 
     // Add a new entry to the list with that raw id
-    this->entries.push_back(SymbolTableEntry({ id, raw_id, node->type, node, {} }));
+    this->entries.push_back(SymbolTableEntry({ id, std::string(raw_id), node->type, node, {} }));
+    this->index_entry(this->entries.size() - 1);
 }
 
 /* Removes a symbol with given id from the table. Note that it simply does nothing if the id isn't present. */
 void SymbolTable::remove(const std::string& id) {
-    // Compute the raw id first
-    std::string raw_id = get_raw(id);
-
-    // Check to see if this id (as a raw_id) occurs in the table
-    for (std::vector<SymbolTableEntry>::const_iterator iter = this->entries.begin(); iter != this->entries.end(); ++iter) {
-        if ((*iter).raw_id == raw_id) {
-            // We can remove it!
-            this->entries.erase(iter);
-            return;
-        }
-    }
-
-    // Otherwise, we did found nothing but that's okay
-    return;
+    // Check to see if this id (as a raw_id) occurs in the table, and remove it if so
+    this->remove(this->lookup(get_raw(id)));
 }
 
 /* Removes a symbol at the given location from the table. Note that it simply does nothing if the table is not that large. */
@@ -131,63 +163,44 @@ void SymbolTable::remove(size_t index) {
     // Check if within bounds
     if (index >= this->entries.size()) { return; }
 
-    // Otherwise, remove it
+    // Otherwise, remove it; since the later entries shift, the index has to be rebuilt
     this->entries.erase(this->entries.begin() + index);
+    this->reindex();
 }
 
 
 
 /* Returns whether or not a symbol with the given id exists. */
 bool SymbolTable::contains(const std::string& id) const {
-    // Compute the raw id first
-    std::string raw_id = get_raw(id);
+    return this->lookup(get_raw(id)) < this->entries.size();
+}
 
-    // Loop to search for it
-    for (size_t i = 0; i < this->entries.size(); i++) {
-        if (this->entries[i].raw_id == raw_id) {
-            // Found it
-            return true;
-        }
-    }
 
-    // Did not find it
-    return false;
-}
 
+/* Returns a pointer to the symbol table entry with the given identifier, or a nullptr if it's not present. */
+SymbolTableEntry* SymbolTable::find(const std::string& id) {
+    size_t i = this->lookup(get_raw(id));
+    return i < this->entries.size() ? &this->entries[i] : nullptr;
+}
 
+/* Returns a constant pointer to the symbol table entry with the given identifier, or a nullptr if it's not present. */
+const SymbolTableEntry* SymbolTable::find(const std::string& id) const {
+    size_t i = this->lookup(get_raw(id));
+    return i < this->entries.size() ? &this->entries[i] : nullptr;
+}
 
 /* Returns a muteable reference to the symbol table entry with the given identifier. Might throw errors if not present. */
 SymbolTableEntry& SymbolTable::at(const std::string& id) {
-    // Compute the raw id first
-    std::string raw_id = get_raw(id);
-
-    // Loop to search for it
-    for (size_t i = 0; i < this->entries.size(); i++) {
-        if (this->entries[i].raw_id == raw_id) {
-            // Found it
-            return this->entries[i];
-        }
-    }
-
-    // Did not find it
-    throw std::runtime_error("Cannot return unknown SymbolTableEntry with id '" + id + "'");
+    SymbolTableEntry* entry = this->find(id);
+    if (entry == nullptr) { throw std::runtime_error("Cannot return unknown SymbolTableEntry with id '" + id + "'"); }
+    return *entry;
 }
 
 /* Returns a constant reference to the symbol table entry with the given identifier. Might throw errors if not present. */
 const SymbolTableEntry& SymbolTable::at(const std::string& id) const {
-    // Compute the raw id first
-    std::string raw_id = get_raw(id);
-
-    // Loop to search for it
-    for (size_t i = 0; i < this->entries.size(); i++) {
-        if (this->entries[i].raw_id == raw_id) {
-            // Found it
-            return this->entries[i];
-        }
-    }
-
-    // Did not find it
-    throw std::runtime_error("Cannot return unknown SymbolTableEntry with id '" + id + "'");
+    const SymbolTableEntry* entry = this->find(id);
+    if (entry == nullptr) { throw std::runtime_error("Cannot return unknown SymbolTableEntry with id '" + id + "'"); }
+    return *entry;
 }
 
 
@@ -4,7 +4,7 @@
  * Created:
  *   05/11/2020, 16:17:44
  * Last edited:
- *   2/9/2021, 3:50:38 PM
+ *   18/10/2026, 20:04:03
  * Auto updated?
  *   Yes
  *
@@ -19,6 +19,7 @@
 #include <sstream>
 #include <fstream>
 
+#include "SourceManager.hpp"
 #include "ADLTokenizer.hpp"
 
 using namespace std;
@@ -40,6 +41,8 @@ using namespace ArgumentParser;
         if (is_whitespace(c)) { \
             REJECT(c); \
             goto start; \
+        } else if (c == EOF) { \
+            goto start; \
         } else { \
             ACCEPT(c); \
         } \
@@ -60,9 +63,9 @@ using namespace ArgumentParser;
 #define ACCEPT(C) \
     if ((C) != EOF) { ++this->col; }
 
-/* Rejects a token from the stream, by putting it back. */
+/* Rejects a token from the stream, by putting it back. An EOF needs no putting back, since the stream keeps giving those anyway. */
 #define REJECT(C) \
-    this->file->putback((C));
+    if ((C) != EOF) { this->file->putback((C)); }
 
 /* Parses given Token as a number (i.e., integral value) and returns it as a ValueToken. */
 Token* parse_number(Token* token) {
@@ -71,37 +74,25 @@ Token* parse_number(Token* token) {
     long result = 0;
     long modifier = 1;
 
-    // If the number is negative, reflect that in the modifier and get rid of the raw minus
-    if (raw.substr(0, 3) == "---") {
-        raw = raw.substr(3);
+    // If the number is negative, reflect that in the modifier and get rid of the raw minus (the tokenizer only keeps the last of the three dashes)
+    if (raw.size() > 0 && raw[0] == '-') {
+        raw = raw.substr(1);
         modifier *= -1;
     }
 
-    // Loop and add the numbers
-    bool warned = false;
+    // Loop and add the numbers, checking before each step that it stays within a long (since signed overflow is undefined)
     for (size_t i = 0; i < raw.size(); i++) {
         long value = (long) (raw[i] - '0');
-        if (modifier > 0) {
-            // Check if it won't get out-of-bounds for the positive add
-            if (!warned && result > (numeric_limits<long>::max() / 10.0) - value) {
-                Exceptions::log(Exceptions::OverflowWarning(token->debug));
-                warned = true;
-            }
-
-            // If it didn't, add it
-            result *= 10;
-            result += value;
-        } else {
-            // Check if it won't get out-of-bounds for the negative add
-            if (!warned && result < (numeric_limits<long>::min() / 10.0) + value) {
-                Exceptions::log(Exceptions::UnderflowWarning(token->debug));
-                warned = true;
-            }
-
-            // If it didn't, add it
-            result *= 10;
-            result -= value;
+        if (modifier > 0 ? result > (numeric_limits<long>::max() - value) / 10 : result < (numeric_limits<long>::min() + value) / 10) {
+            // Let the user know, and stick to the closest value we can store
+            Exceptions::log(Exceptions::IntegerTooLargeException(token->debug));
+            result = modifier > 0 ? numeric_limits<long>::max() : numeric_limits<long>::min();
+            break;
         }
+
+        // It fits, so add it
+        result *= 10;
+        result += modifier * value;
     }
 
     // Done, so create a ValueToken and return it
@@ -126,7 +117,7 @@ Token* parse_decimal(Token* token) {
         result = modifier * std::stod(raw);
     } catch (std::out_of_range& e) {
         // Print as the overflow warning
-        Exceptions::log(Exceptions::FloatOverflowWarning(token->debug));
+        Exceptions::warn<Exceptions::FloatOverflowWarning>(token->debug);
         result = std::numeric_limits<double>::max();
     }
 
@@ -166,22 +157,28 @@ std::ostream& ValueToken<T>::print(std::ostream& os) const {
     return os << tokentype_names[(int) this->type] << "(" << this->value << ")";
 }
 
+/* Override for the polymorphic print function for references, which store the position of their dot as value but should be printed by their raw value. */
+template <>
+std::ostream& ValueToken<size_t>::print(std::ostream& os) const {
+    return os << tokentype_names[(int) this->type] << "(" << this->raw << ")";
+}
+
 /* Override for the polymorphic print function to beautify boolean printing. */
 template <>
 std::ostream& ValueToken<bool>::print(std::ostream& os) const {
     return os << tokentype_names[(int) this->type] << "(" << (this->value ? "true" : "false") << ")";
 }
 
-/* "Promotes" an existing Token to a ValueToken, by copying it and adding our value. Note that the given token will be deallocated. */
+/* "Promotes" an existing Token to a ValueToken, by moving its properties and adding our value. Note that the given token will be deallocated. */
 template <class T>
 ValueToken<T>* ValueToken<T>::promote(Token* other, const T& value) {
     // Create a new ValueToken
     ValueToken* result = new ValueToken<T>();
 
-    // Copy the token's properties
+    // Steal the token's properties, since it will be deallocated anyway
     result->type = other->type;
-    result->debug = other->debug;
-    result->raw = other->raw;
+    result->debug = std::move(other->debug);
+    result->raw = std::move(other->raw);
 
     // Inject the value
     result->value = value;
@@ -211,35 +208,50 @@ Tokenizer::Tokenizer(std::istream* stream, const std::vector<std::string>& filen
     file(stream),
     line(1),
     col(1),
-    last_newline(0),
     done_tokenizing(false),
     filenames(filenames),
-    path(filenames[filenames.size() - 1])
+    path(filenames[filenames.size() - 1]),
+    source(SourceManager::none)
 {
-    // Check if opening the file succeeded
+    // Check if opening the file succeeded; since the destructor won't run if we throw, we free the stream ourselves
     if (dynamic_cast<ifstream*>(stream) && !((ifstream*) stream)->is_open()) {
+        int err = errno;
+        delete stream;
         throw Exceptions::log(
-            Exceptions::FileOpenError(filenames, errno)
+            Exceptions::FileOpenError(filenames, err)
         );
     }
 
+    // Hand the file's contents to the source manager, so diagnostics can show where they point to
+    this->source = source_manager.load(this->path, *stream, true);
+
     // Reserve space for at least one token on the stream
     this->temp.reserve(1);
 }
 
+/* Constructor for the Tokenizer class, which takes an input stream that is already positioned somewhere in a file, a path of file breadcrumbs and the line & column number that position corresponds to. Used to tokenize only a part of a file. */
+Tokenizer::Tokenizer(std::istream* stream, const std::vector<std::string>& filenames, size_t line, size_t col) :
+    Tokenizer(stream, filenames)
+{
+    // Continue counting from the given position
+    this->line = line;
+    this->col = col;
+}
+
 /* Move constructor for the Tokenizer class. */
 Tokenizer::Tokenizer(Tokenizer&& other) :
     file(other.file),
     line(other.line),
     col(other.col),
-    last_newline(other.last_newline),
     done_tokenizing(other.done_tokenizing),
     temp(other.temp),
     filenames(other.filenames),
-    path(other.path)
+    path(other.path),
+    source(other.source)
 {
-    // Set the other's file pointer to NULL
+    // Set the other's file pointer to NULL, and let it no longer release the file's contents
     other.file = nullptr;
+    other.source = SourceManager::none;
 
     // Also clear the other's list of tokens
     other.temp.clear();
@@ -247,8 +259,9 @@ Tokenizer::Tokenizer(Tokenizer&& other) :
 
 /* Destructor for the Tokenizer class. */
 Tokenizer::~Tokenizer() {
-    // Close the file
+    // Close the file, and let the source manager know we no longer need its contents
     if (this->file != nullptr) { delete this->file; }
+    if (this->source != SourceManager::none) { source_manager.release(this->source); }
 
     // Deallocate the temporary tokens
     for (size_t i = 0; i < this->temp.size(); i++) {
@@ -274,16 +287,29 @@ Token* Tokenizer::read_head() {
     // Otherwise, parse from the stream
     char c;
     Token* result = new Token();
+    // Position of the dot in references
+    size_t dot = 0;
 
 start:
     {
+        // Stop reading altogether once the active handler has seen as many errors as it may store
+        if (Exceptions::ExceptionHandler::current().exhausted()) {
+            result->type = TokenType::empty;
+            result->debug.filenames = this->filenames;
+            result->debug.line1 = this->line;
+            result->debug.col1 = this->col;
+            result->debug.line2 = this->line;
+            result->debug.col2 = this->col;
+            this->done_tokenizing = true;
+            return result;
+        }
+
         // Get the head character on the stream
         PEEK(c);
 
         // We can already deduce the line at this point, so put it in the result
         result->raw.clear();
         result->debug.filenames = this->filenames;
-        result->debug.raw_line = this->get_line();
 
         // Choose the correct path forward
         if (c == 'r') {
@@ -421,7 +447,6 @@ start:
             // Increment the line and then try again
             ++this->line;
             this->col = 1;
-            this->last_newline = this->file->tellg();
             goto start;
         } else if (is_whitespace(c)) {
             // Re-try
@@ -439,7 +464,7 @@ start:
         } else {
             // Log the exception, and then move on to a newline
             Exceptions::log(
-                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -499,6 +524,7 @@ id_start:
         } else if (c == '.') {
             // It's a reference!
             result->type = TokenType::reference;
+            dot = result->raw.size();
             STORE(c);
             goto reference_dot;
         } else {
@@ -535,13 +561,13 @@ dash_start:
         } else if (!is_whitespace(c)) {
             // Let the user know we encountered an illegal character
             Exceptions::log(
-                Exceptions::IllegalShortlabelException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::IllegalShortlabelException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         } else {
             // Let the user know we encountered an empty option
             Exceptions::log(
-                Exceptions::EmptyShortlabelException(DebugInfo(DebugInfo(this->filenames, this->line, this->col - 1, this->get_line())))
+                Exceptions::EmptyShortlabelException(DebugInfo(DebugInfo(this->filenames, this->line, this->col - 1)))
             );
             ACCEPT(c);
             goto start;
@@ -559,6 +585,7 @@ shortlabel_end:
         if (c == '.') {
             // It's a reference!
             result->type = TokenType::reference;
+            dot = result->raw.size();
             STORE(c);
             goto reference_dot;
         } else {
@@ -592,13 +619,13 @@ dash_dash:
         } else if (!is_whitespace(c)) {
             // Let the user know we encountered an illegal character
             Exceptions::log(
-                Exceptions::IllegalLonglabelException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::IllegalLonglabelException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         } else {
             // Let the user know we encountered an empty option
             Exceptions::log(
-                Exceptions::EmptyLonglabelException(DebugInfo(DebugInfo(this->filenames, this->line, this->col - 1, this->get_line())))
+                Exceptions::EmptyLonglabelException(DebugInfo(DebugInfo(this->filenames, this->line, this->col - 1)))
             );
             ACCEPT(c);
             goto start;
@@ -623,6 +650,7 @@ dash_dash_longlabel:
         } else if (c == '.') {
             // It's a reference
             result->type = TokenType::reference;
+            dot = result->raw.size();
             STORE(c);
             goto reference_dot;
         } else {
@@ -660,13 +688,13 @@ type_start:
         } else if (c != '>') {
             // Let the user know we encountered an illegal character
             Exceptions::log(
-                Exceptions::IllegalTypeException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::IllegalTypeException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         } else {
             // Let the user know we encountered an empty type id
             Exceptions::log(
-                Exceptions::EmptyTypeException(DebugInfo(this->filenames, this->line, this->col, this->get_line()))
+                Exceptions::EmptyTypeException(DebugInfo(this->filenames, this->line, this->col))
             );
             ACCEPT(c);
             goto start;
@@ -704,7 +732,7 @@ type_contd:
         } else {
             // Illegal character
             Exceptions::log(
-                Exceptions::IllegalTypeException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::IllegalTypeException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -734,6 +762,7 @@ type_end:
 
             // Update the type and the value and parse the property we reference
             result->type = TokenType::reference;
+            dot = result->raw.size();
             STORE(old_c);
             goto reference_dot;
         } else {
@@ -766,17 +795,17 @@ reference_dot:
             if (result->raw[result->raw.size() - 1] == '.') {
                 // We didn't
                 Exceptions::log(
-                    Exceptions::EmptyReferenceException(DebugInfo(this->filenames, this->line, this->col, this->get_line()))
+                    Exceptions::EmptyReferenceException(DebugInfo(this->filenames, this->line, this->col))
                 );
                 REJECT(c);
                 goto start;
             }
 
-            // Otherwise, store the debug info and return
+            // Otherwise, store the debug info and return it together with the position of the dot, so it needn't be searched again
             result->debug.line2 = this->line;
             result->debug.col2 = this->col;
             REJECT(c);
-            return result;
+            return (Token*) ValueToken<size_t>::promote(result, dot);
         }
     }
 
@@ -807,7 +836,7 @@ string_start:
             result->debug.line2 = result->debug.line1;
             result->debug.col2 = result->debug.col1;
             Exceptions::ExceptionHandler& eh = Exceptions::log(
-                Exceptions::UnterminatedStringException(DebugInfo(this->filenames, this->line, this->col, this->get_line())),
+                Exceptions::UnterminatedStringException(DebugInfo(this->filenames, this->line, this->col)),
                 Exceptions::UnterminatedStartNote(result->debug)
             );
             
@@ -821,7 +850,7 @@ string_start:
         } else {
             // Don't accept direct newlines
             Exceptions::log(
-                Exceptions::IllegalStringException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::IllegalStringException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -842,7 +871,7 @@ string_escape:
         } else {
             // Non-readable character is escaped!
             Exceptions::log(
-                Exceptions::IllegalStringException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::IllegalStringException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             ACCEPT(c);
             goto start;
@@ -864,13 +893,13 @@ number_start:
         } else if (!is_whitespace(c)) {
             // Let the user know we encountered an illegal character
             Exceptions::log(
-                Exceptions::IllegalNegativeException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::IllegalNegativeException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         } else {
             // Let the user know we encountered an empty number
             Exceptions::log(
-                Exceptions::EmptyNegativeException(DebugInfo(this->filenames, this->line, this->col - 1, this->get_line()))
+                Exceptions::EmptyNegativeException(DebugInfo(this->filenames, this->line, this->col - 1))
             );
             ACCEPT(c);
             goto start;
@@ -937,7 +966,7 @@ bool_start:
             PEEK(c);
             if (is_whitespace(c) || c == EOF || c == ';') {
                 Exceptions::log(
-                    Exceptions::UnterminatedBooleanException(DebugInfo(this->filenames, result->debug.line1, result->debug.col1, this->line, this->col, result->debug.raw_line))
+                    Exceptions::UnterminatedBooleanException(DebugInfo(this->filenames, result->debug.line1, result->debug.col1, this->line, this->col))
                 );
                 ACCEPT(c);
                 goto start;
@@ -962,7 +991,7 @@ bool_start:
             return ValueToken<bool>::promote(result, false);
         } else if (val.empty()) {
             Exceptions::log(
-                Exceptions::EmptyBooleanException(DebugInfo(this->filenames, this->line, this->col, this->get_line()))
+                Exceptions::EmptyBooleanException(DebugInfo(this->filenames, this->line, this->col))
             );
             ACCEPT(c);
             goto start;
@@ -989,7 +1018,7 @@ snippet_start:
         } else {
             // Otherwise, it doesn't make a lot of sense, so error
             Exceptions::log(
-                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -1010,7 +1039,7 @@ snippet_pp:
         } else {
             // Otherwise, it doesn't make a lot of sense, so error
             Exceptions::log(
-                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -1038,9 +1067,14 @@ snippet_code:
             // Store, but also increment the line counter
             ++this->line;
             this->col = 1;
-            this->last_newline = this->file->tellg();
             result->raw.push_back(c);
             goto snippet_code;
+        } else if (c == EOF) {
+            // The file ended before the snippet did
+            throw Exceptions::log(
+                Exceptions::UnterminatedSnippetException(DebugInfo(this->filenames, this->line, this->col)),
+                Exceptions::UnterminatedStartNote(result->debug)
+            );
         } else {
             // Add to the token's value and keep parsing more snippet
             STORE(c);
@@ -1081,7 +1115,6 @@ snippet_end:
             result->raw.pop_back();
             result->debug.line2 = this->line;
             result->debug.col2 = this->col;
-            result->debug.raw_line = this->get_line();
             ACCEPT(c);
             return result;
         } else {
@@ -1107,7 +1140,6 @@ snippet_comment_start:
             // Treat it as a multi-line comment, further noting its start
             debug.line2 = this->line;
             debug.col2 = this->col;
-            debug.raw_line = this->get_line();
             STORE(c);
             goto snippet_multiline_start;
         } else {
@@ -1129,6 +1161,9 @@ snippet_singleline_start:
             // We're done; put it back on the stream and go back to normal snippet parsing
             REJECT(c);
             goto snippet_code;
+        } else if (c == EOF) {
+            // Let normal snippet parsing find out the file ended
+            goto snippet_code;
         } else {
             // Simply keep adding all tokens to the token
             STORE(c);
@@ -1152,13 +1187,12 @@ snippet_multiline_start:
             // Skip, but do update the line counters
             this->col = 1;
             this->line++;
-            this->last_newline = this->file->tellg();
             result->raw.push_back(c);
             goto snippet_multiline_start;
         } else if (c == EOF) {
             // Whoa! Reached unterminated comment!
             throw Exceptions::log(
-                Exceptions::UnterminatedMultilineException(DebugInfo(this->filenames, this->line, this->col, this->get_line())),
+                Exceptions::UnterminatedMultilineException(DebugInfo(this->filenames, this->line, this->col)),
                 Exceptions::UnterminatedStartNote(debug)
             );
         } else {
@@ -1216,7 +1250,7 @@ dot_start:
         } else {
             // Didn't expect that
             Exceptions::log(
-                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -1239,7 +1273,7 @@ triple_dot_end:
         } else {
             // Didn't expect that
             Exceptions::log(
-                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -1285,13 +1319,12 @@ comment_start:
             // Multi-line comment, further noting the start of it
             debug.line2 = this->line;
             debug.col2 = this->col;
-            debug.raw_line = this->get_line();
             ACCEPT(c);
             goto multiline_start;
         } else {
             // Otherwise, it doesn't make a lot of sense, so error
             Exceptions::log(
-                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c)
+                Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c)
             );
             RETRY_AT_WHITESPACE();
         }
@@ -1309,6 +1342,9 @@ singleline_start:
             // We're done; put it back on the stream and go back to start
             REJECT(c);
             goto start;
+        } else if (c == EOF) {
+            // The comment ran until the end of the file, which start will see as well
+            goto start;
         } else {
             // Simply keep discarding all tokens
             ACCEPT(c);
@@ -1332,12 +1368,11 @@ multiline_start:
             // Skip, but do update the line counters
             this->col = 1;
             this->line++;
-            this->last_newline = this->file->tellg();
             goto multiline_start;
         } else if (c == EOF) {
             // Whoa! Reached unterminated comment!
             throw Exceptions::log(
-                Exceptions::UnterminatedMultilineException(DebugInfo(this->filenames, this->line, this->col, this->get_line())),
+                Exceptions::UnterminatedMultilineException(DebugInfo(this->filenames, this->line, this->col)),
                 Exceptions::UnterminatedStartNote(debug)
             );
         } else {
@@ -1388,7 +1423,7 @@ macro_start:
         } else if (result->raw.size() == 0) {
             // Empty macro
             Exceptions::log(
-                Exceptions::EmptyMacroException(DebugInfo(this->filenames, this->line, this->col, this->get_line()))
+                Exceptions::EmptyMacroException(DebugInfo(this->filenames, this->line, this->col))
             );
             REJECT(c);
             goto start;
@@ -1417,7 +1452,7 @@ macro_and:
             return result;
         } else {
             // Illegal token
-            Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c));
+            Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c));
             RETRY_AT_WHITESPACE();
         }
     }
@@ -1438,7 +1473,7 @@ macro_or:
             return result;
         } else {
             // Illegal token
-            Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c));
+            Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c));
             RETRY_AT_WHITESPACE();
         }
     }
@@ -1468,7 +1503,7 @@ warning_start:
             goto error_token;
         } else {
             // Unknown token
-            Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c));
+            Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c));
             RETRY_AT_WHITESPACE();
         }
     }
@@ -1483,7 +1518,7 @@ suppress_token:
             PEEK(c);
             if (c != uppress[i]) {
                 // Unknown token
-                Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c));
+                Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c));
                 RETRY_AT_WHITESPACE();
             }
             if (i < 6) { STORE(c); }
@@ -1506,7 +1541,7 @@ warning_token:
             PEEK(c);
             if (c != arning[i]) {
                 // Unknown token
-                Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c));
+                Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c));
                 RETRY_AT_WHITESPACE();
             }
             if (i < 5) { STORE(c); }
@@ -1529,7 +1564,7 @@ error_token:
             PEEK(c);
             if (c != arning[i]) {
                 // Unknown token
-                Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col, this->get_line()), c));
+                Exceptions::log(Exceptions::UnexpectedCharException(DebugInfo(this->filenames, this->line, this->col), c));
                 RETRY_AT_WHITESPACE();
             }
             if (i < 3) { STORE(c); }
@@ -1543,48 +1578,6 @@ error_token:
     }
 }
 
-/* Reads the entire, given line from the internal file, used for error messaging. */
-LineSnippet Tokenizer::get_line() {
-    // Store the current file position
-    long cursor = this->file->tellg();
-
-    // Restore the file stream indicator to the most recent newline
-    this->file->seekg(this->last_newline);
-
-    // We are now at the start of the correct line; read until we encounter EOF or newline
-    std::stringstream sstr;
-    while (true) {
-        char c;
-        PEEK(c);
-        sstr << c;
-        if (c == '\n' || c == EOF) {
-            // Restore the initial file position and return
-            this->file->seekg(cursor);
-            break;
-        }
-    }
-
-    // Reduce the size of the string to 100 if needed, by laternatingly take of one at the end and the start
-    std::string result = sstr.str();
-    size_t c1 = 0;
-    size_t c2 = result.size() - 1;
-    size_t oversize = result.size() > 100 ? result.size() - 100 : 0;
-    for (size_t i = 0; i < oversize; i++) {
-        if (i % 2 == 0) {
-            result.pop_back();
-            --c2;
-        } else {
-            result = std::string(result.c_str() + 1);
-            --c1;
-        }
-    }
-
-    // Done, return
-    return LineSnippet(c1, c2, result);
-}
-
-
-
 /* Looks at the top token of the stream without removing it. */
 Token* Tokenizer::peek() {
     // Read the token at the head of the stream
@@ -0,0 +1,74 @@
+/* ADLARENA.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:04:20
+ * Last edited:
+ *   18/10/2026, 14:12:01
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the ADLArena class, which is a simple bump allocator that
+ *   owns the memory of all nodes of a single ADLTree. Nodes allocated in
+ *   an arena are not freed one-by-one; instead, all of their memory is
+ *   released in bulk once the arena itself is destroyed. Also contains
+ *   an allocator that can be used to let std-containers (like the
+ *   children of an ADLBranch) allocate in an arena.
+**/
+
+#include "ADLArena.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** ADLARENA CLASS *****/
+
+/* The arena in which nodes are currently allocated on this thread, if any. */
+thread_local ADLArena* ADLArena::active = nullptr;
+
+
+
+/* Default constructor for the ADLArena class. */
+ADLArena::ADLArena() :
+    head(nullptr),
+    left(0),
+    n_bytes(0)
+{}
+
+/* Destructor for the ADLArena class, which releases all memory allocated in it. */
+ADLArena::~ADLArena() {
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        ::operator delete(this->blocks[i]);
+    }
+}
+
+
+
+/* Allocates the given number of bytes in the arena. The memory stays valid until the arena is destroyed. */
+void* ADLArena::allocate(size_t n) {
+    // Round the size up so the next allocation is aligned too
+    n = (n + ADLArena::alignment - 1) & ~(ADLArena::alignment - 1);
+    this->n_bytes += n;
+
+    // Oversized allocations get a block of their own, so we don't waste the current one
+    if (n > ADLArena::block_size) {
+        char* block = (char*) ::operator new(n);
+        this->blocks.push_back(block);
+        return (void*) block;
+    }
+
+    // Otherwise, start a new block if the current one is too full
+    if (n > this->left) {
+        this->head = (char*) ::operator new(ADLArena::block_size);
+        this->left = ADLArena::block_size;
+        this->blocks.push_back(this->head);
+    }
+
+    // Bump the head
+    void* result = (void*) this->head;
+    this->head += n;
+    this->left -= n;
+    return result;
+}
@@ -4,7 +4,7 @@
  * Created:
  *   26/11/2020, 11:39:35
  * Last edited:
- *   04/01/2021, 17:50:39
+ *   18/10/2026, 19:23:05
  * Auto updated?
  *   Yes
  *
@@ -22,13 +22,30 @@ using namespace std;
 using namespace ArgumentParser;
 
 
+/***** HELPER FUNCTIONS *****/
+/* Returns the context string of the given function on a branch of the given type, for use in exceptions. Only called once something goes wrong, so the common path doesn't pay for building it. */
+static std::string context(NodeType type, const char* function) {
+    return "ADL" + nodetype_name.at(type) + "::" + function;
+}
+
+
+
+
+
 /***** ADLBRANCH CLASS *****/
 
+/* Whether the traversal on this thread is currently somewhere below a branch that is shared between trees. */
+thread_local bool ADLBranch::in_shared = false;
+
+
+
+
 /* Constructor for the ADLBranch class, which takes the type of the derived node, a DebugInfo struct linking this node to a location in the source file and optionally a NodeType denoting all accepted children types. */
 ADLBranch::ADLBranch(NodeType type, const DebugInfo& debug, NodeType whitelist) :
     ADLNode(type, debug),
     has_max(false),
-    whitelist(whitelist)
+    whitelist(whitelist),
+    children(ArenaAllocator<ADLNode*>(ADLArena::current()))
 {}
 
 /* Constructor for the ADLBranch class, which takes the type of the derived node, a DebugInfo struct linking this node to a location in the source file, the maximum number of children to allow and optionally a NodeType denoting all accepted children types. */
@@ -36,20 +53,23 @@ ADLBranch::ADLBranch(NodeType type, const DebugInfo& debug, size_t max, NodeType
     ADLNode(type, debug),
     has_max(true),
     max(max),
-    whitelist(whitelist)
+    whitelist(whitelist),
+    children(ArenaAllocator<ADLNode*>(ADLArena::current()))
 {}
 
-/* Copy constructor for the ADLBranch class. */
+/* Copy constructor for the ADLBranch class, which shares the children with the other branch instead of copying them. The parent of the shared children keeps pointing to the other branch. */
 ADLBranch::ADLBranch(const ADLBranch& other) :
     ADLNode(other),
     has_max(other.has_max),
     max(other.max),
-    whitelist(other.whitelist)
+    whitelist(other.whitelist),
+    children(ArenaAllocator<ADLNode*>(ADLArena::current()))
 {
-    // Copy all the children nodes
+    // Share all the children nodes; they are only copied once they are replaced (see traverse_recurse())
     this->children.reserve(other.children.size());
     for (size_t i = 0; i < other.children.size(); i++) {
-        this->add_node(other.children[i]->copy());
+        this->children.push_back(other.children[i]);
+        ++other.children[i]->refs;
     }
 }
 
@@ -58,12 +78,14 @@ ADLBranch::ADLBranch(ADLBranch&& other) :
     ADLNode(other),
     has_max(other.has_max),
     max(other.max),
-    whitelist(other.whitelist)
+    whitelist(other.whitelist),
+    children(ArenaAllocator<ADLNode*>(ADLArena::current()))
 {
-    // Move all the children nodes to us
+    // Move all the children nodes to us, taking over the other's hold on them
     this->children.reserve(other.children.size());
     for (size_t i = 0; i < other.children.size(); i++) {
-        this->add_node(other.children[i]);
+        this->children.push_back(other.children[i]);
+        other.children[i]->parent = this;
     }
 
     // Clear the other's list, to avoid it deallocating them
@@ -72,9 +94,9 @@ ADLBranch::ADLBranch(ADLBranch&& other) :
 
 /* Virtual destructor for the ADLBranch class. */
 ADLBranch::~ADLBranch() {
-    // Simply delete all children we have
+    // Release all children we have, which deletes those that aren't shared with another branch
     for (size_t i = 0; i < this->children.size(); i++) {
-        delete this->children[i];
+        ADLNode::release(this->children[i]);
     }
 }
 
@@ -82,22 +104,38 @@ ADLBranch::~ADLBranch() {
 
 /* Adds a node as child of this node. */
 void ADLBranch::add_node(ADLNode* node) {
-    std::string context = "ADL" + nodetype_name.at(this->type) + "::add_node()";
-
     // Check if we have a maximum and, if so, if we're at it
     if (this->has_max && this->children.size() == this->max) {
-        throw Exceptions::MaximumChildrenException(context, "???", this->max);
+        throw Exceptions::MaximumChildrenException(context(this->type, "add_node()"), "???", this->max);
     }
     // Make sure the node is of a valid type
     if (!(node->type & this->whitelist)) {
-        throw Exceptions::IllegalChildException(context, "???", this->whitelist, node->type);
+        throw Exceptions::IllegalChildException(context(this->type, "add_node()"), "???", this->whitelist, node->type);
     }
 
     // Finally, just add the node and set its parent
     this->children.push_back(node);
+    ++node->refs;
+    node->parent = this;
+}
+
+
+
+/* Replaces the child at the given index with the given node, releasing the old one. Derived classes that keep pointers to their children are told through rebind(). */
+void ADLBranch::replace_child(size_t index, ADLNode* node) {
+    ADLNode* old_node = this->children[index];
+    this->children[index] = node;
+    ++node->refs;
     node->parent = this;
+
+    // Let derived classes move their pointers before the old node may be gone
+    this->rebind(old_node, node);
+    ADLNode::release(old_node);
 }
 
+/* Lets derived classes that keep pointers to some of their children point them to the given new node if they pointed to the given old one. Called whenever a child is replaced, before the old one is released. Does nothing by default. */
+void ADLBranch::rebind(ADLNode*, ADLNode*) {}
+
 
 
 /* Returns all nodes (as vector) with the given type(s) stored as child of this node. */
@@ -121,11 +159,12 @@ std::vector<ADLNode*> ADLBranch::get_nodes(NodeType type) const {
 
 
 
-/* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-void ADLBranch::traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*)) {
-    std::string context = "ADL" + nodetype_name.at(this->type) + "::traverse_recurse(stateless)";
+/* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Returns the node to use in place of this one, which is a copy if this node is shared and one of its children was replaced. */
+ADLNode* ADLBranch::traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*)) {
+    SharedScope scope(this);
 
     // Simply loop through all children, possibly replacing them
+    ADLBranch* result = this;
     for (size_t i = 0; i < this->children.size(); i++) {
         ADLNode* new_node = this->children[i]->traverse(trav_id, node_types, trav_func);
 
@@ -133,22 +172,27 @@ void ADLBranch::traverse_recurse(const char* trav_id, NodeType node_types, ADLNo
         if (new_node != this->children[i]) {
             // If it's replaced, be sure that it's a whitelisted node
             if (!(new_node->type & this->whitelist)) {
-                throw Exceptions::IllegalChildException(context, trav_id, this->whitelist, new_node->type);
+                throw Exceptions::IllegalChildException(context(this->type, "traverse_recurse(stateless)"), trav_id, this->whitelist, new_node->type);
             }
 
+            // If another tree can see us, replace the child in a copy of ourselves instead
+            if (ADLBranch::in_shared && result == this) { result = (ADLBranch*) this->copy(); }
+
             // If it was valid, continue replacing it
-            delete this->children[i];
-            this->children[i] = new_node;
-            new_node->parent = this;
+            result->replace_child(i, new_node);
         }
     }
+
+    // Done; tell the parent whether we were copied
+    return result;
 }
 
-/* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-void ADLBranch::traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state) {
-    std::string context = "ADL" + nodetype_name.at(this->type) + "::traverse_recurse()";
+/* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Returns the node to use in place of this one, which is a copy if this node is shared and one of its children was replaced. */
+ADLNode* ADLBranch::traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state) {
+    SharedScope scope(this);
 
     // Simply loop through all children, possibly replacing them
+    ADLBranch* result = this;
     for (size_t i = 0; i < this->children.size(); i++) {
         ADLNode* new_node = this->children[i]->traverse(trav_id, node_types, trav_func, state);
 
@@ -156,13 +200,17 @@ void ADLBranch::traverse_recurse(const char* trav_id, NodeType node_types, ADLNo
         if (new_node != this->children[i]) {
             // If it's replaced, be sure that it's a whitelisted node
             if (!(new_node->type & this->whitelist)) {
-                throw Exceptions::IllegalChildException(context, trav_id, this->whitelist, new_node->type);
+                throw Exceptions::IllegalChildException(context(this->type, "traverse_recurse()"), trav_id, this->whitelist, new_node->type);
             }
 
+            // If another tree can see us, replace the child in a copy of ourselves instead
+            if (ADLBranch::in_shared && result == this) { result = (ADLBranch*) this->copy(); }
+
             // If it was valid, continue replacing it
-            delete this->children[i];
-            this->children[i] = new_node;
-            new_node->parent = this;
+            result->replace_child(i, new_node);
         }
     }
+
+    // Done; tell the parent whether we were copied
+    return result;
 }
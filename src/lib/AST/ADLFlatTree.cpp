@@ -0,0 +1,73 @@
+/* ADLFLAT TREE.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:22:40
+ * Last edited:
+ *   18/10/2026, 14:25:48
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the ADLFlatTree class, which is a flattened view on a parsed
+ *   AST. The nodes are stored in pre-order in a set of parallel arrays
+ *   (their types, parents, first children, next siblings and the nodes
+ *   themselves), so that passes that only need the tree's structure can
+ *   stream through it linearly instead of chasing pointers.
+**/
+
+#include "ADLVisitor.hpp"
+#include "ADLFlatTree.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** VISITORS *****/
+/* Visitor that appends every node it visits to the given flat tree, in pre-order. */
+struct FlattenVisitor {
+    /* The flat tree to append to. */
+    ADLFlatTree& flat;
+    /* The index of the parent of the nodes we're currently visiting. */
+    uint32_t parent;
+    /* The index of the last child added to the current parent, if any. */
+    uint32_t last_child;
+
+    /* Appends the given node and, recursively, its children. */
+    ADLNode* operator()(const char* trav_id, ADLNode* node) {
+        // Add the node itself
+        uint32_t index = (uint32_t) this->flat.size();
+        this->flat.types.push_back(node->type);
+        this->flat.parents.push_back(this->parent);
+        this->flat.first_children.push_back(ADLFlatTree::none);
+        this->flat.next_siblings.push_back(ADLFlatTree::none);
+        this->flat.nodes.push_back(node);
+
+        // Link it to its parent or its previous sibling
+        if (this->last_child != ADLFlatTree::none) { this->flat.next_siblings[this->last_child] = index; }
+        else if (this->parent != ADLFlatTree::none) { this->flat.first_children[this->parent] = index; }
+
+        // Add the children with ourselves as parent, then restore the state for our own siblings
+        uint32_t parent = this->parent;
+        this->parent = index;
+        this->last_child = ADLFlatTree::none;
+        visit_children(trav_id, node, nt_all, *this);
+        this->parent = parent;
+        this->last_child = index;
+
+        return node;
+    }
+};
+
+
+
+
+
+/***** ADLFLATTREE CLASS *****/
+
+/* Constructor for the ADLFlatTree class, which flattens the (sub)tree rooted at the given node. Note that the flat tree refers to the nodes, so it is only valid for as long as the tree is not changed. */
+ADLFlatTree::ADLFlatTree(ADLNode* root) {
+    // Simply visit all nodes with the flattening visitor
+    FlattenVisitor visitor({ *this, ADLFlatTree::none, ADLFlatTree::none });
+    visit("flatten", root, nt_all, visitor);
+}
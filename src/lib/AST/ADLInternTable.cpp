@@ -0,0 +1,50 @@
+/* ADLINTERN TABLE.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:44:04
+ * Last edited:
+ *   18/10/2026, 19:55:11
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the InternTable class, which stores each distinct identifier,
+ *   label, property name or type name of a compilation only once. Each
+ *   string is given a 32-bit id, so that nodes can compare them as
+ *   integers instead of as strings.
+**/
+
+#include "ADLInternTable.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** INTERNTABLE CLASS *****/
+
+/* The intern table used by nodes constructed on this thread, if any. */
+thread_local InternTable* InternTable::active = nullptr;
+
+
+
+/* Returns the id of the given string, adding it to the table if it isn't interned yet. */
+intern_t InternTable::intern(const std::string_view& str) {
+    // Return the existing id if we know it already
+    std::unordered_map<std::string_view, intern_t>::const_iterator iter = this->ids.find(str);
+    if (iter != this->ids.end()) { return iter->second; }
+
+    // Otherwise, store the string and register the view on our own copy
+    intern_t id = (intern_t) this->strings.size();
+    this->strings.emplace_back(str);
+    this->ids.insert({ std::string_view(this->strings.back()), id });
+    return id;
+}
+
+
+
+/* Returns the intern table used by nodes constructed on this thread. Throws a NoInternTableException if no table is active, since there is no table that each compilation could share without it growing forever. */
+InternTable& InternTable::current() {
+    if (InternTable::active == nullptr) { throw NoInternTableException(); }
+    return *InternTable::active;
+}
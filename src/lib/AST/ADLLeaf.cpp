@@ -4,7 +4,7 @@
  * Created:
  *   26/11/2020, 11:33:54
  * Last edited:
- *   04/01/2021, 17:52:18
+ *   18/10/2026, 15:06:56
  * Auto updated?
  *   Yes
  *
@@ -26,16 +26,21 @@ ADLLeaf::ADLLeaf(NodeType type, const DebugInfo& debug) :
     ADLNode(type, debug)
 {}
 
+/* Constructor for the ADLLeaf, which takes the type of the derived file and a DebugInfo struct containing the information where this node came from, which is moved into the node. */
+ADLLeaf::ADLLeaf(NodeType type, DebugInfo&& debug) :
+    ADLNode(type, std::move(debug))
+{}
+
 
 
-/* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-void ADLLeaf::traverse_recurse(const char*, NodeType, ADLNode* (*)(const char*, ADLNode*)) {
+/* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Always returns this node itself, as leaves have no children to replace. */
+ADLNode* ADLLeaf::traverse_recurse(const char*, NodeType, ADLNode* (*)(const char*, ADLNode*)) {
     // Simply do not recurse, as this node doesn't have any children
-    return;
+    return this;
 }
 
-/* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-void ADLLeaf::traverse_recurse(const char*, NodeType, ADLNode* (*)(const char*, ADLNode*, void*), void*) {
+/* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Always returns this node itself, as leaves have no children to replace. */
+ADLNode* ADLLeaf::traverse_recurse(const char*, NodeType, ADLNode* (*)(const char*, ADLNode*, void*), void*) {
     // Simply do not recurse, as this node doesn't have any children
-    return;
+    return this;
 }
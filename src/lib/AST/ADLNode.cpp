@@ -4,7 +4,7 @@
  * Created:
  *   18/11/2020, 20:39:22
  * Last edited:
- *   04/01/2021, 17:51:57
+ *   18/10/2026, 17:04:09
  * Auto updated?
  *   Yes
  *
@@ -21,13 +21,64 @@ using namespace ArgumentParser;
 
 /***** ADLNODE CLASS *****/
 
-/* Constructor for the ADLNode, which takes the type of the node and the debug information of where this nodes originates. Note that it automatically assings all currently suppressed tokens in the static error handler as suppressed for this node. */
+/* The number of bytes reserved before each node to remember where it was allocated, which is kept at the arena's alignment so the node itself stays aligned. */
+static constexpr size_t header_size = ADLArena::alignment;
+
+
+
+
+/* Constructor for the ADLNode, which takes the type of the node and the debug information of where this nodes originates. */
 ADLNode::ADLNode(NodeType type, const DebugInfo& debug) :
     type(type),
     debug(debug),
-    suppressed(Exceptions::error_handler.toplevel_suppressed | Exceptions::error_handler.config_suppressed)
+    parent(nullptr),
+    refs(0)
+{}
+
+/* Constructor for the ADLNode, which takes the type of the node and the debug information of where this nodes originates, which is moved into the node. */
+ADLNode::ADLNode(NodeType type, DebugInfo&& debug) :
+    type(type),
+    debug(std::move(debug)),
+    parent(nullptr),
+    refs(0)
 {}
 
+/* Copy constructor for the ADLNode, which copies everything except the number of branches holding the node. */
+ADLNode::ADLNode(const ADLNode& other) :
+    type(other.type),
+    debug(other.debug),
+    parent(other.parent),
+    refs(0)
+{}
+
+
+
+/* Allocates memory for a node in the currently active ADLArena, or on the heap if there is none. */
+void* ADLNode::operator new(size_t n) {
+    // Allocate the node together with a header that stores where it lives
+    ADLArena* arena = ADLArena::current();
+    char* memory = (char*) (arena != nullptr ? arena->allocate(header_size + n) : ::operator new(header_size + n));
+    *((ADLArena**) memory) = arena;
+    return (void*) (memory + header_size);
+}
+
+/* Deallocates the memory of a node, which only does something if it was allocated on the heap; arena memory is released with the arena itself. */
+void ADLNode::operator delete(void* ptr) {
+    if (ptr == nullptr) { return; }
+
+    // Only free the memory if the header tells us it's not in an arena
+    char* memory = ((char*) ptr) - header_size;
+    if (*((ADLArena**) memory) == nullptr) { ::operator delete((void*) memory); }
+}
+
+
+
+/* Drops one of the branches holding the given node, deallocating the node once none are left. */
+void ADLNode::release(ADLNode* node) {
+    if (node->refs > 1) { --node->refs; }
+    else { delete node; }
+}
+
 
 
 /* Actual traversal-function for stateless traversal. Takes a list of nodes to traverse (in order), which nodes we should trigger the traversal function and the (stateless) traversal function itself. */
@@ -37,12 +88,9 @@ ADLNode* ADLNode::traverse(const char* trav_id, NodeType node_types, ADLNode* (*
         // Note that in this case, we leave it to the traversal function to actually recurse deeper (so it may choose the timing)
         return trav_func(trav_id, this);
     } else {
-        // Default to the normal recursion
-        this->traverse_recurse(trav_id, node_types, trav_func);
+        // Default to the normal recursion, which may give us a copy of ourselves if we're shared
+        return this->traverse_recurse(trav_id, node_types, trav_func);
     }
-    
-    // Otherwise, just return ourselves
-    return this;
 }
 
 /* Actual traversal-function for traversal. Takes a list of nodes to traverse (in order), which nodes we should trigger the traversal function, the traversal function itself and the initial state. */
@@ -52,10 +100,7 @@ ADLNode* ADLNode::traverse(const char* trav_id, NodeType node_types, ADLNode* (*
         // Note that in this case, we leave it to the traversal function to actually recurse deeper (so it may choose the timing)
         return trav_func(trav_id, this, state);
     } else {
-        // Default to the normal recursion
-        this->traverse_recurse(trav_id, node_types, trav_func, state);
+        // Default to the normal recursion, which may give us a copy of ourselves if we're shared
+        return this->traverse_recurse(trav_id, node_types, trav_func, state);
     }
-    
-    // Otherwise, just return ourselves
-    return this;
 }
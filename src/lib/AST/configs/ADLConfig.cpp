@@ -4,7 +4,7 @@
  * Created:
  *   27/11/2020, 16:24:34
  * Last edited:
- *   08/12/2020, 20:45:27
+ *   18/10/2026, 14:50:23
  * Auto updated?
  *   Yes
  *
@@ -22,10 +22,11 @@ using namespace ArgumentParser;
 
 /***** ADLCONFIG CLASS *****/
 
-/* Constructor for the ADLConfig class, which takes debug information on the node's origin, the name of the parameter configured and a list of values as ADLValues. */
-ADLConfig::ADLConfig(const DebugInfo& debug, const std::string& param, ADLValues* values) :
+/* Constructor for the ADLConfig class, which takes debug information on the node's origin, the name of the parameter configured (which is interned in the current intern table) and a list of values as ADLValues. */
+ADLConfig::ADLConfig(const DebugInfo& debug, const std::string_view& param, ADLValues* values) :
     ADLBranch(NodeType::config, debug, 1, NodeType::values),
-    param(param)
+    param_id(InternTable::current().intern(param)),
+    param(InternTable::current().str(this->param_id))
 {
     // Add the values node
     this->add_node(values);
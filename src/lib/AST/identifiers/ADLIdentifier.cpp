@@ -4,7 +4,7 @@
  * Created:
  *   10/12/2020, 16:34:15
  * Last edited:
- *   12/12/2020, 16:59:05
+ *   18/10/2026, 14:50:23
  * Auto updated?
  *   Yes
  *
@@ -24,10 +24,19 @@ using namespace ArgumentParser;
 
 /***** ADLIDENTIFIER CLASS *****/
 
-/* Constructor for the ADLIdentifier class, which takes debugging information, the identifier value we wrap and the type of said identifier. */
-ADLIdentifier::ADLIdentifier(const DebugInfo& debug, const std::string& identifier, IdentifierType identifier_type) :
+/* Constructor for the ADLIdentifier class, which takes debugging information, the identifier value we wrap (which is interned in the current intern table) and the type of said identifier. */
+ADLIdentifier::ADLIdentifier(const DebugInfo& debug, const std::string_view& identifier, IdentifierType identifier_type) :
     ADLLeaf(NodeType::identifier, debug),
-    identifier(identifier),
+    id(InternTable::current().intern(identifier)),
+    identifier(InternTable::current().str(this->id)),
+    type(identifier_type)
+{}
+
+/* Constructor for the ADLIdentifier class, which takes debugging information, the identifier value we wrap (which is interned in the current intern table) and the type of said identifier. The debugging information is moved into the node. */
+ADLIdentifier::ADLIdentifier(DebugInfo&& debug, const std::string_view& identifier, IdentifierType identifier_type) :
+    ADLLeaf(NodeType::identifier, std::move(debug)),
+    id(InternTable::current().intern(identifier)),
+    identifier(InternTable::current().str(this->id)),
     type(identifier_type)
 {}
 
@@ -4,7 +4,7 @@
  * Created:
  *   04/01/2021, 18:08:55
  * Last edited:
- *   05/01/2021, 13:58:23
+ *   18/10/2026, 19:26:15
  * Auto updated?
  *   Yes
  *
@@ -143,13 +143,14 @@ ADLDefinition::ADLDefinition(NodeType type, const DebugInfo& debug, size_t max_c
     if (configs != nullptr) { this->add_node((ADLNode*) configs); }
 }
 
-/* Copy constructor for the ADLDefinition class. */
+/* Copy constructor for the ADLDefinition class, which shares the children with the other definition but copies its symbol table, so either can be changed without affecting the other. Like the references into the definition, its entries keep pointing to the nodes of the other one. */
 ADLDefinition::ADLDefinition(const ADLDefinition& other) :
     ADLBranch(other),
     identifier(nullptr),
     shortlabel(nullptr),
     longlabel(nullptr),
-    configs(nullptr)
+    configs(nullptr),
+    symbol_table(other.symbol_table)
 {
     // Re-write the identifier pointers
     vector<ADLNode*> nodes = this->get_nodes(NodeType::identifier);
@@ -188,3 +189,14 @@ void ADLDefinition::add_node(ADLNode* node) {
         this->configs = (ADLConfigs*) this->children[this->children.size() - 1];
     }
 }
+
+
+
+/* Points the identifier, label or configs pointer that pointed to the given old child to the given new one instead, or to nothing if the new child isn't of the same type. */
+void ADLDefinition::rebind(ADLNode* old_node, ADLNode* new_node) {
+    ADLIdentifier* new_identifier = new_node->type == NodeType::identifier ? (ADLIdentifier*) new_node : nullptr;
+    if (this->identifier == old_node) { this->identifier = new_identifier; }
+    if (this->shortlabel == old_node) { this->shortlabel = new_identifier; }
+    if (this->longlabel == old_node) { this->longlabel = new_identifier; }
+    if (this->configs == old_node) { this->configs = new_node->type == NodeType::configs ? (ADLConfigs*) new_node : nullptr; }
+}
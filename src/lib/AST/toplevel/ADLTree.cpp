@@ -4,7 +4,7 @@
  * Created:
  *   18/11/2020, 20:47:57
  * Last edited:
- *   11/02/2021, 18:00:10
+ *   18/10/2026, 19:43:52
  * Auto updated?
  *   Yes
  *
@@ -24,12 +24,52 @@ using namespace ArgumentParser;
 
 /* Constructor for the ADLTree class, which takes the filename of the root file and optionally takes a toplevel node. */
 ADLTree::ADLTree(const std::string& root_file, ADLNode* toplevel) :
-    ADLDefinition(NodeType::root, DebugInfo({ root_file }, 0, 0, LineSnippet("")), nt_toplevel, nullptr)
+    ADLDefinition(NodeType::root, DebugInfo({ root_file }, 0, 0), nt_toplevel, nullptr)
 {
     // Add the node if it isn't NULL
     if (toplevel != nullptr) { this->add_node(toplevel); }
 }
 
+/* Copy constructor for the ADLTree class, which shares the other's nodes and retains its files once more. */
+ADLTree::ADLTree(const ADLTree& other) :
+    ADLDefinition(other),
+    arena(other.arena),
+    interns(other.interns),
+    suppressions(other.suppressions),
+    sources(other.sources)
+{
+    for (size_t i = 0; i < this->sources.size(); i++) {
+        source_manager.retain(this->sources[i]);
+    }
+}
+
+/* Destructor for the ADLTree class, which releases all nodes before the arena they may live in is released, and then the files the tree was parsed from. */
+ADLTree::~ADLTree() {
+    // Release the children already, since the arena member is destroyed before the ADLBranch destructor runs
+    for (size_t i = 0; i < this->children.size(); i++) {
+        ADLNode::release(this->children[i]);
+    }
+    this->children.clear();
+
+    // Let the source manager know we no longer need the files' contents
+    for (size_t i = 0; i < this->sources.size(); i++) {
+        source_manager.release(this->sources[i]);
+    }
+}
+
+
+
+/* Allocates memory for the tree itself, which always lives on the heap since it owns the arena its children may live in. */
+void* ADLTree::operator new(size_t n) {
+    ADLArena::Scope scope(nullptr);
+    return ADLNode::operator new(n);
+}
+
+/* Deallocates the memory of the tree itself. */
+void ADLTree::operator delete(void* ptr) {
+    ADLNode::operator delete(ptr);
+}
+
 
 
 /* Lets the Tree-node have a go at trying to store the given value/node for the given property key. Returns 'true' if it was successfull, or 'false' if no such property is relevant for this class. */
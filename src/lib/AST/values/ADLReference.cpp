@@ -4,7 +4,7 @@
  * Created:
  *   30/11/2020, 17:49:49
  * Last edited:
- *   11/02/2021, 16:53:19
+ *   18/10/2026, 17:58:42
  * Auto updated?
  *   Yes
  *
@@ -24,13 +24,21 @@ using namespace ArgumentParser;
 ADLReference::ADLReference(const DebugInfo& debug, ADLIdentifier* definition, ADLIdentifier* property) :
     ADLBranch(NodeType::reference, debug, 2, NodeType::identifier),
     definition(definition),
-    property(property)
+    property(property),
+    reference(nullptr)
 {
     // Add the ID and identifier as our children
     this->add_node((ADLNode*) definition);
     this->add_node((ADLNode*) property);
 }
 
+/* Points the definition or property pointer that pointed to the given old child to the given new one instead. */
+void ADLReference::rebind(ADLNode* old_node, ADLNode* new_node) {
+    // Our whitelist only allows identifiers, so the new node is always one
+    if (this->definition == old_node) { this->definition = (ADLIdentifier*) new_node; }
+    if (this->property == old_node) { this->property = (ADLIdentifier*) new_node; }
+}
+
 /* Prints the reference to the given output stream. */
 std::ostream& ADLReference::print(std::ostream& os) const {
     this->definition->print(os);
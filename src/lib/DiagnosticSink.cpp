@@ -0,0 +1,67 @@
+/* DIAGNOSTIC SINK.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 17:09:21
+ * Last edited:
+ *   18/10/2026, 17:09:21
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the DiagnosticSink class, which collects the diagnostics of
+ *   the tasks that make up one phase of a compilation (e.g., one file or
+ *   definition each) while they run on different threads. Each task logs
+ *   to a handler of its own, so collecting needs no locks at all, and
+ *   once the phase is done they are merged in task order and written in
+ *   source order. The output is thus the same no matter how the tasks
+ *   were scheduled, or whether they ran on threads at all.
+**/
+
+#include "DiagnosticSink.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+using namespace ArgumentParser::Exceptions;
+
+
+/***** DIAGNOSTICSINK CLASS *****/
+
+/* Constructor for the DiagnosticSink class, which takes the handler that the diagnostics of each phase end up in. */
+DiagnosticSink::DiagnosticSink(ExceptionHandler& target) :
+    target(target)
+{}
+
+
+
+/* Starts a phase of the given number of tasks, giving each an empty handler with the same settings as the target. Must be called before any of the tasks starts. */
+void DiagnosticSink::begin(size_t n_tasks) {
+    this->tasks.clear();
+    this->tasks.reserve(n_tasks);
+    for (size_t i = 0; i < n_tasks; i++) {
+        // The tasks never print themselves; that's left to the target once the phase is over
+        this->tasks.emplace_back(false);
+        ExceptionHandler& handler = this->tasks.back();
+        handler.colour = this->target.colour;
+        handler.output_format = this->target.output_format;
+        handler.max_errors = this->target.max_errors;
+        handler.max_warnings = this->target.max_warnings;
+        handler.suppressed_types = this->target.suppressed_types;
+    }
+}
+
+/* Ends the phase by merging the handlers of its tasks into the target in task order, after all tasks have finished. If the target prints on add, the whole phase is written at once, sorted by source location. Returns the target. */
+ExceptionHandler& DiagnosticSink::end() {
+    // Merge everything before printing anything, so the diagnostics of all tasks are sorted together
+    bool print_on_add = this->target.print_on_add;
+    this->target.print_on_add = false;
+    for (size_t i = 0; i < this->tasks.size(); i++) {
+        this->target.merge(this->tasks[i]);
+    }
+    this->target.print_on_add = print_on_add;
+    this->tasks.clear();
+
+    // Write the phase in one go if the target would have done so itself
+    if (this->target.print_on_add) { this->target.flush(std::cerr); }
+    return this->target;
+}
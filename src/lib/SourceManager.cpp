@@ -0,0 +1,223 @@
+/* SOURCE MANAGER.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 16:21:40
+ * Last edited:
+ *   18/10/2026, 20:16:26
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the SourceManager class, which keeps the contents of every
+ *   file that is tokenized together with a table of where each of its
+ *   lines starts. Diagnostics only carry positions, and the snippet of
+ *   source they show is cut from the file once it's rendered. The
+ *   contents are freed once the trees and handlers that retained them
+ *   are gone.
+**/
+
+#include <algorithm>
+
+#include "SourceManager.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** SOURCEMANAGER CLASS *****/
+
+/* Stores the given bytes as the contents of the file at the given path, replacing any earlier contents (and the snippets cut from them) if they differ. If retain is true, the file is retained in the same go, so no other thread can free it in between. Returns the id of the file. */
+file_t SourceManager::add(const std::string& path, std::string&& bytes, bool retain) {
+    std::unique_lock<std::mutex> guard(this->lock);
+
+    // If we know the file already, only replace it if it has changed (or if its contents were freed, in which case it has no lines)
+    std::unordered_map<std::string, file_t>::const_iterator iter = this->ids.find(path);
+    file_t id;
+    if (iter != this->ids.end()) {
+        id = iter->second;
+        if (retain) { ++this->files[id].users; }
+        if (!this->files[id].lines.empty() && this->files[id].bytes == bytes) { return id; }
+    } else {
+        id = (file_t) this->files.size();
+        this->files.emplace_back();
+        this->files.back().path = path;
+        this->files.back().users = retain ? 1 : 0;
+        this->ids.insert({ path, id });
+    }
+    SourceFile& file = this->files[id];
+    file.bytes = std::move(bytes);
+    file.snippets.clear();
+
+    // Note where each line starts
+    file.lines.clear();
+    file.lines.push_back(0);
+    for (size_t i = 0; i < file.bytes.size(); i++) {
+        if (file.bytes[i] == '\n') { file.lines.push_back(i + 1); }
+    }
+    return id;
+}
+
+/* Stores the contents of the given stream as those of the file at the given path, reading it from the start and then restoring its position. If retain is true, the file is retained in the same go. Returns the id of the file, or SourceManager::none if the stream can't be rewound. */
+file_t SourceManager::load(const std::string& path, std::istream& stream, bool retain) {
+    // Streams that can't tell us where they are can't be read twice either
+    std::streampos cursor = stream.tellg();
+    if (cursor == std::streampos(-1)) { return SourceManager::none; }
+
+    // Read everything in one go
+    stream.seekg(0, std::ios::end);
+    std::streampos size = stream.tellg();
+    stream.seekg(0, std::ios::beg);
+    std::string bytes((size_t) size, '\0');
+    stream.read(&bytes[0], size);
+    bytes.resize((size_t) stream.gcount());
+
+    // Go back to where the stream was
+    stream.clear();
+    stream.seekg(cursor);
+    return this->add(path, std::move(bytes), retain);
+}
+
+/* Returns the id of the file at the given path, or SourceManager::none if it isn't known. */
+file_t SourceManager::find(const std::string& path) const {
+    std::unique_lock<std::mutex> guard(this->lock);
+    std::unordered_map<std::string, file_t>::const_iterator iter = this->ids.find(path);
+    return iter != this->ids.end() ? iter->second : SourceManager::none;
+}
+
+/* Forgets all files, e.g., in between unrelated compilations in one process. Diagnostics of earlier compilations can no longer show their snippets afterwards. */
+void SourceManager::clear() {
+    std::unique_lock<std::mutex> guard(this->lock);
+    this->files.clear();
+    this->ids.clear();
+    this->trails.clear();
+    this->trail_ids.clear();
+}
+
+
+
+/* Returns the id of the given include path (a file preceded by the files that included it), adding it if it's new. Include paths are never forgotten until clear(), since there are only as many as there are include chains. */
+trail_t SourceManager::trail(const std::vector<std::string>& filenames) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    std::map<std::vector<std::string>, trail_t>::const_iterator iter = this->trail_ids.find(filenames);
+    if (iter != this->trail_ids.end()) { return iter->second; }
+
+    // Otherwise, add it
+    trail_t id = (trail_t) this->trails.size();
+    this->trails.push_back(filenames);
+    this->trail_ids.insert({ filenames, id });
+    return id;
+}
+
+/* Returns the include path with the given id. */
+const std::vector<std::string>& SourceManager::filenames(trail_t trail) const {
+    std::unique_lock<std::mutex> guard(this->lock);
+    return this->trails[trail];
+}
+
+
+
+/* Keeps the contents of the given file until it's released as often as it's been retained. Should only be called for files that are already retained (or that were just added), since the contents of files that have been freed don't come back. */
+void SourceManager::retain(file_t file) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    if (file < this->files.size()) { ++this->files[file].users; }
+}
+
+/* Releases the given file once, freeing its contents (and the snippets cut from them) if nobody retains it anymore. Files that were never retained are kept until clear(). */
+void SourceManager::release(file_t file) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    if (file >= this->files.size() || this->files[file].users == 0) { return; }
+
+    // Swap the contents with empty ones, since clearing them would keep their memory
+    SourceFile& source = this->files[file];
+    if (--source.users > 0) { return; }
+    std::string().swap(source.bytes);
+    std::vector<size_t>().swap(source.lines);
+    std::unordered_map<uint64_t, LineSnippet>().swap(source.snippets);
+}
+
+
+
+/* Returns the number of bytes in the given file, which is 0 once its contents have been freed. */
+size_t SourceManager::length(file_t file) const {
+    std::unique_lock<std::mutex> guard(this->lock);
+    return this->files[file].bytes.size();
+}
+
+/* Returns the byte offset of the given line & column number in the given file. Positions past the end of a line or the file are clamped to it, and all positions are at 0 in files whose contents have been freed. */
+size_t SourceManager::offset(file_t file, size_t line, size_t col) const {
+    std::unique_lock<std::mutex> guard(this->lock);
+    const SourceFile& source = this->files[file];
+    if (source.lines.empty()) { return 0; }
+
+    // Find the start and end of the line
+    if (line < 1) { line = 1; }
+    if (line > source.lines.size()) { line = source.lines.size(); }
+    size_t start = source.lines[line - 1];
+    size_t end = line < source.lines.size() ? source.lines[line] - 1 : source.bytes.size();
+
+    // Move to the column within it
+    return col > 1 ? std::min(start + col - 1, end) : start;
+}
+
+/* Returns one past the byte offset of the given line & column number in the file that the given include path ends in, or 0 if that file isn't known or its contents have been freed. Positions are clamped like offset() does. */
+size_t SourceManager::trail_offset(trail_t trail, size_t line, size_t col) const {
+    std::unique_lock<std::mutex> guard(this->lock);
+    const std::vector<std::string>& filenames = this->trails[trail];
+    std::unordered_map<std::string, file_t>::const_iterator iter = this->ids.find(filenames[filenames.size() - 1]);
+    if (iter == this->ids.end()) { return 0; }
+    const SourceFile& source = this->files[iter->second];
+    if (source.lines.empty()) { return 0; }
+
+    // Find the start and end of the line
+    if (line < 1) { line = 1; }
+    if (line > source.lines.size()) { line = source.lines.size(); }
+    size_t start = source.lines[line - 1];
+    size_t end = line < source.lines.size() ? source.lines[line] - 1 : source.bytes.size();
+
+    // Move to the column within it
+    return (col > 1 ? std::min(start + col - 1, end) : start) + 1;
+}
+
+/* Returns the line & column number of the given byte offset in the given file through the given references, which are both 0 if the file's contents have been freed. */
+void SourceManager::position(file_t file, size_t offset, size_t& line, size_t& col) const {
+    std::unique_lock<std::mutex> guard(this->lock);
+    const SourceFile& source = this->files[file];
+    if (source.lines.empty()) { line = 0; col = 0; return; }
+
+    // The line is the last one that starts at or before the offset
+    line = std::upper_bound(source.lines.begin(), source.lines.end(), offset) - source.lines.begin();
+    col = offset - source.lines[line - 1] + 1;
+}
+
+/* Copies at most snippet_width columns of the given line in the given file, chosen such that the given column is in them, to the given snippet. The window is cut only once for all columns that share it. Returns false if there is no such line. */
+bool SourceManager::snippet(file_t file, size_t line, size_t col, LineSnippet& result) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    SourceFile& source = this->files[file];
+    if (line < 1 || line > source.lines.size()) { return false; }
+
+    // Find the line, without its newline
+    size_t start = source.lines[line - 1];
+    size_t end = line < source.lines.size() ? source.lines[line] - 1 : source.bytes.size();
+    if (end > start && source.bytes[end - 1] == '\r') { --end; }
+
+    // Lines that are too long are cut in windows that start every half width, such that the column has at least a quarter width of context on either side
+    size_t window = 0;
+    size_t first = 0;
+    size_t half = SourceManager::snippet_width / 2;
+    if (end - start > SourceManager::snippet_width) {
+        window = col > 1 ? (col - 1) / half : 0;
+        first = window * half > half / 2 ? window * half - half / 2 : 0;
+        first = std::min(first, end - start - SourceManager::snippet_width);
+    }
+
+    // Return the window if we've cut it before, or cut it now
+    uint64_t key = ((uint64_t) line << 32) | (uint64_t) window;
+    std::unordered_map<uint64_t, LineSnippet>::const_iterator iter = source.snippets.find(key);
+    if (iter == source.snippets.end()) {
+        size_t size = std::min(end - start - first, SourceManager::snippet_width);
+        iter = source.snippets.insert({ key, LineSnippet(first + 1, first + size, source.bytes.substr(start + first, size)) }).first;
+    }
+    result = iter->second;
+    return true;
+}
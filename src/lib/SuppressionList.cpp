@@ -0,0 +1,179 @@
+/* SUPPRESSION LIST.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 16:58:12
+ * Last edited:
+ *   18/10/2026, 19:56:04
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the SuppressionList class, which records which warnings are
+ *   suppressed where in the source files of a compilation. Each @suppress
+ *   modifier becomes a span of source over which a set of warning types
+ *   is suppressed, so whether a warning is suppressed only depends on
+ *   where it points to, no matter when it is logged.
+**/
+
+#include <algorithm>
+#include <iostream>
+
+#include "SuppressionList.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+using namespace ArgumentParser::Exceptions;
+
+
+/***** HELPER FUNCTIONS *****/
+/* Returns whether the first position comes before the second one. */
+static inline bool before(size_t line1, size_t col1, size_t line2, size_t col2) {
+    return line1 < line2 || (line1 == line2 && col1 < col2);
+}
+
+/* Moves the given position by the given number of lines, and by the given number of columns if it's on the given line. */
+static inline void shift(size_t& line, size_t& col, size_t on_line, long lines, long cols) {
+    if (line == SuppressionList::open) { return; }
+    if (line == on_line) { col += cols; }
+    line += lines;
+}
+
+
+
+
+
+/***** SUPPRESSIONLIST CLASS *****/
+
+/* The suppression list used by the parser and the handler on this thread, if any. */
+thread_local SuppressionList* SuppressionList::active = nullptr;
+
+
+
+/* Returns whether the first span starts before the second one. */
+bool SuppressionList::starts_before(const Span& s1, const Span& s2) {
+    return before(s1.line1, s1.col1, s2.line1, s2.col1);
+}
+
+
+
+/* Default constructor for the SuppressionList class. */
+SuppressionList::SuppressionList() :
+    all_types((WarningType) 0)
+{}
+
+
+
+/* Suppresses the given warning types from the given position on, in the given scope. If the last span of that scope in the position's file is still open, the types are added to it instead. */
+void SuppressionList::suppress(SuppressionScope scope, const DebugInfo& start, WarningType types) {
+    #ifdef DEBUG
+    std::cout << "[  Suppression  ] Suppressed " << extract_type_names(types) << " from " << start.line1 << ":" << start.col1 << "." << std::endl;
+    #endif
+    if (start.filenames.empty()) { return; }
+    this->all_types = this->all_types | types;
+
+    // Stack the types onto an open span, or start a new one
+    std::vector<Span>& spans = this->files[start.filenames[start.filenames.size() - 1]].scopes[(int) scope];
+    if (!spans.empty() && spans.back().line2 == SuppressionList::open) {
+        spans.back().types = spans.back().types | types;
+    } else {
+        spans.push_back({ start.line1, start.col1, SuppressionList::open, 0, types });
+    }
+}
+
+/* Closes the open span of the given scope in the file of the given position (if any) at the end of that position. */
+void SuppressionList::close(SuppressionScope scope, const DebugInfo& end) {
+    if (end.filenames.empty()) { return; }
+    std::unordered_map<std::string, FileSpans>::iterator iter = this->files.find(end.filenames[end.filenames.size() - 1]);
+    if (iter == this->files.end()) { return; }
+    std::vector<Span>& spans = iter->second.scopes[(int) scope];
+    if (spans.empty() || spans.back().line2 != SuppressionList::open) { return; }
+
+    // A span that would end before it starts doesn't cover anything
+    Span& span = spans.back();
+    if (before(end.line2, end.col2, span.line1, span.col1)) {
+        spans.pop_back();
+        return;
+    }
+    span.line2 = end.line2;
+    span.col2 = end.col2;
+}
+
+/* Replaces all spans that start within the given range of the file it points to with the spans that the given list has for that file, moving the spans after the range such that it ends at the given position, and letting any span that ended at the end of the range end at the given position too. */
+void SuppressionList::splice(const DebugInfo& range, const SuppressionList& other, size_t line2, size_t col2) {
+    if (range.filenames.empty()) { return; }
+    const std::string& path = range.filenames[range.filenames.size() - 1];
+    long lines = (long) line2 - (long) range.line2;
+    long cols = (long) col2 - (long) range.col2;
+
+    // Find the spans to add
+    const FileSpans* added = nullptr;
+    std::unordered_map<std::string, FileSpans>::const_iterator iter = other.files.find(path);
+    if (iter != other.files.end()) { added = &iter->second; }
+    this->all_types = this->all_types | other.all_types;
+
+    FileSpans& file = this->files[path];
+    for (int s = 0; s < 2; s++) {
+        std::vector<Span> spans;
+        spans.reserve(file.scopes[s].size() + (added != nullptr ? added->scopes[s].size() : 0));
+        for (size_t i = 0; i < file.scopes[s].size(); i++) {
+            Span span = file.scopes[s][i];
+            bool starts_after = before(range.line2, range.col2, span.line1, span.col1);
+
+            // Drop the spans that were part of the range
+            if (!before(span.line1, span.col1, range.line1, range.col1) && !starts_after) { continue; }
+
+            // Move the start of spans after the range, and the end of any span that ends at or after the end of the range
+            if (starts_after) { shift(span.line1, span.col1, range.line2, lines, cols); }
+            if (span.line2 != SuppressionList::open && !before(span.line2, span.col2, range.line2, range.col2)) { shift(span.line2, span.col2, range.line2, lines, cols); }
+            spans.push_back(span);
+        }
+
+        // Add the new spans and put everything in order again
+        if (added != nullptr) { spans.insert(spans.end(), added->scopes[s].begin(), added->scopes[s].end()); }
+        std::sort(spans.begin(), spans.end(), SuppressionList::starts_before);
+        file.scopes[s] = std::move(spans);
+    }
+}
+
+
+
+/* Returns the warning types that are suppressed over the whole of the given position, i.e., by spans that contain it from its start to its end. */
+WarningType SuppressionList::suppressed(const DebugInfo& at) const {
+    if (at.filenames.empty()) { return (WarningType) 0; }
+    std::unordered_map<std::string, FileSpans>::const_iterator iter = this->files.find(at.filenames[at.filenames.size() - 1]);
+    if (iter == this->files.end()) { return (WarningType) 0; }
+
+    // In each scope, only the last span starting at or before the position can contain it
+    WarningType result = (WarningType) 0;
+    for (int s = 0; s < 2; s++) {
+        const std::vector<Span>& spans = iter->second.scopes[s];
+        size_t lo = 0, hi = spans.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (before(at.line1, at.col1, spans[mid].line1, spans[mid].col1)) { hi = mid; }
+            else { lo = mid + 1; }
+        }
+        if (lo == 0) { continue; }
+        const Span& span = spans[lo - 1];
+        if (span.line2 == SuppressionList::open || !before(span.line2, span.col2, at.line2, at.col2)) { result = result | span.types; }
+    }
+    return result;
+}
+
+/* Returns the number of spans in the list. */
+size_t SuppressionList::size() const {
+    size_t result = 0;
+    for (const std::pair<const std::string, FileSpans>& file : this->files) {
+        result += file.second.scopes[0].size() + file.second.scopes[1].size();
+    }
+    return result;
+}
+
+
+
+/* Returns the suppression list used on this thread. Throws a NoSuppressionListException if no list is active, since there is no list that each compilation could share without it growing forever. */
+SuppressionList& SuppressionList::current() {
+    if (SuppressionList::active == nullptr) { throw NoSuppressionListException(); }
+    return *SuppressionList::active;
+}
@@ -4,7 +4,7 @@
  * Created:
  *   13/11/2020, 15:33:50
  * Last edited:
- *   13/12/2020, 15:08:52
+ *   18/10/2026, 18:57:55
  * Auto updated?
  *   Yes
  *
@@ -96,6 +96,18 @@ NonTerminal::NonTerminal(ADLNode* node) :
     _node(node)
 {}
 
+/* Copy constructor for the NonTerminal, which copies the node as well. */
+NonTerminal::NonTerminal(const NonTerminal& other) :
+    Symbol(other),
+    _node(other._node != nullptr ? other._node->copy() : nullptr)
+{}
+
+/* Destructor for the NonTerminal, which frees the node unless a parent has adopted it or it was taken out (by setting node() to a nullptr). */
+NonTerminal::~NonTerminal() {
+    // Nodes that were adopted are the parent's to free
+    if (this->_node != nullptr && this->_node->refs == 0) { delete this->_node; }
+}
+
 
 
 /* Lets the NonTerminal print itself to the given output stream. */
@@ -284,6 +296,14 @@ void SymbolStack::add_terminal(Token* token) {
     this->symbols[this->length++] = (Symbol*) term;
 }
 
+/* Adds an already constructed NonTerminal on the stack. */
+void SymbolStack::add_nonterminal(NonTerminal* symbol) {
+    // Make sure there is enough space left
+    if (this->length >= this->max_length) { this->resize(); }
+    // Add the nonterminal symbol
+    this->symbols[this->length++] = (Symbol*) symbol;
+}
+
 /* Replaces the first N symbols (deallocating them) with the new NonTerminal. */
 void SymbolStack::replace(size_t N, NonTerminal* symbol) {
     this->remove(N);
@@ -296,6 +316,9 @@ void SymbolStack::replace(size_t N, NonTerminal* symbol) {
 
 /* Removes the N first symbols from the stack (deallocating them). */
 void SymbolStack::remove(size_t N) {
+    // Error rules may count the empty symbol past the bottom of the stack, which there's nothing to remove of
+    if (N > this->length) { N = this->length; }
+
     // Loop & deallocate
     for (size_t i = 0; i < N; i++) {
         delete this->symbols[this->length - 1 - i];
@@ -4,7 +4,7 @@
  * Created:
  *   14/11/2020, 16:14:52
  * Last edited:
- *   2/9/2021, 3:35:45 PM
+ *   18/10/2026, 20:16:26
  * Auto updated?
  *   Yes
  *
@@ -16,13 +16,16 @@
 #ifndef ADL_EXCEPTIONS_HPP
 #define ADL_EXCEPTIONS_HPP
 
+#include <cstdint>
 #include <iostream>
 #include <exception>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <ostream>
+#include <utility>
 
+#include "SourceManager.hpp"
 #include "WarningTypes.hpp"
 #include "DebugInfo.hpp"
 
@@ -40,24 +43,115 @@ namespace ArgumentParser::Exceptions {
 
 
 
+    /* The different kinds of diagnostics that can be logged, which decides how they are rendered. */
+    enum class DiagnosticKind : uint8_t {
+        /* A non-recoverable error that isn't tied to a position in a file. */
+        error = 0,
+        /* A non-recoverable error at a position in a file. */
+        compile_error = 1,
+        /* A warning that isn't tied to a position in a file. */
+        warning = 2,
+        /* A warning at a position in a file. */
+        compile_warning = 3,
+        /* A note accompanying an error or warning, at a position in a file. */
+        note = 4
+    };
+    /* The severity of a diagnostic, which decides whether it counts as an error and whether it may be suppressed. */
+    enum class Severity : uint8_t {
+        /* The diagnostic is a non-recoverable error. */
+        error = 0,
+        /* The diagnostic is a warning, which may be suppressed. */
+        warning = 1,
+        /* The diagnostic is a note accompanying another one. */
+        note = 2
+    };
+    /* The formats in which an ExceptionHandler can write its diagnostics. */
+    enum class DiagnosticsFormat {
+        /* Human-readable text in the style of GCC, with a snippet of the offending source. */
+        text,
+        /* One JSON object per line for each diagnostic, with its notes nested in it. */
+        json,
+        /* A single SARIF 2.1.0 log, with one result per diagnostic. */
+        sarif
+    };
+    /* Returns the severity of diagnostics of the given kind. */
+    inline constexpr Severity severity_of(DiagnosticKind kind) {
+        return kind == DiagnosticKind::error || kind == DiagnosticKind::compile_error ? Severity::error : (kind == DiagnosticKind::note ? Severity::note : Severity::warning);
+    }
+
+    /* Compact location of a diagnostic, which refers to its include path by its id in the source manager instead of carrying the filenames itself. */
+    struct Location {
+        /* The id of the include path of the file the diagnostic is in. */
+        trail_t trail;
+        /* The line number of the start of the diagnostic. */
+        uint32_t line1;
+        /* The column number of the start of the diagnostic. */
+        uint32_t col1;
+        /* The line number of the end of the diagnostic. */
+        uint32_t line2;
+        /* The column number of the end of the diagnostic. */
+        uint32_t col2;
+        /* One past the byte offset of the start of the diagnostic in its file, or 0 if it has no position or the source manager didn't have the file's contents when it was logged. */
+        uint32_t offset;
+
+        /* Default constructor for the Location struct, which leaves it uninitialized. */
+        Location() = default;
+        /* Constructor for the Location struct, which takes the DebugInfo to compact. Its include path is added to the source manager if it's new. */
+        Location(const DebugInfo& debug);
+        /* Constructor for the Location struct, which takes the id of the include path of the given DebugInfo (which is thus known already) and the DebugInfo to take the position from. The byte offset is looked up right away, while the file is certainly still around. */
+        Location(trail_t trail, const DebugInfo& debug);
+
+        /* Returns the include path of the file the diagnostic is in, where the file itself comes last. */
+        inline const std::vector<std::string>& filenames() const { return source_manager.filenames(this->trail); }
+        /* Returns the path of the file the diagnostic is in. */
+        inline const std::string& path() const { const std::vector<std::string>& filenames = this->filenames(); return filenames[filenames.size() - 1]; }
+    };
+
+    /* Formats the given message template by replacing each '{i}' in it with the i'th of the given arguments (where i is a single digit). */
+    std::string format_message(const char* format, const std::string* args, size_t n_args);
+    /* Renders a diagnostic of the given kind to the end of the given buffer, using its location, its warning type (only used for warnings) and its formatted message. Escape sequences for colours are only written if colour is true. */
+    void render_diagnostic(std::string& buffer, DiagnosticKind kind, WarningType type, const Location& location, const std::string& message, bool colour);
+    /* Prints a diagnostic of the given kind to the given output stream in one write, using its location, its warning type (only used for warnings) and its formatted message. */
+    std::ostream& print_diagnostic(std::ostream& os, DiagnosticKind kind, WarningType type, const DebugInfo& debug, const std::string& message, bool colour = true);
+
+
+
     /* Baseclass for all exceptions used throughout the parser. */
     class ADLException : public std::exception {
+    private:
+        /* The formatted message, which is only computed once what() is called. */
+        mutable std::string formatted;
+
     public:
-        /* The include path of the filenames we want to parse. */
-        const std::vector<std::string> filenames;
-        /* The actual message we got. */
-        const std::string message;
-
-        /* Constructor for the ADLException class, which takes the relevant include path of files and optionally a message. */
-        ADLException(const std::vector<std::string>& filenames, const std::string& message = "") :
-            filenames(filenames),
-            message(message)
+        /* The kind of diagnostic this exception is, which is fixed by the baseclass it derives from. */
+        const DiagnosticKind kind;
+        /* The severity of this exception, which follows from its kind. */
+        const Severity severity;
+        /* The location of whatever caused this exception. For exceptions that aren't tied to a position in a file, only the include path of files is set. */
+        const DebugInfo debug;
+        /* The template of the message, which refers to its arguments as '{0}', '{1}', etc. Should always point to a string literal. */
+        const char* const format;
+        /* The arguments that are filled in the message template. */
+        const std::vector<std::string> args;
+
+        /* Constructor for the ADLException class, which takes the kind of diagnostic it is, the location of the exception, optionally the template of a message and the arguments to fill in it. */
+        ADLException(DiagnosticKind kind, const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            kind(kind),
+            severity(severity_of(kind)),
+            debug(debug),
+            format(format),
+            args(args)
         {
-            if (filenames.size() < 1) { throw BreadcrumbException(); }
+            if (debug.filenames.size() < 1) { throw BreadcrumbException(); }
         }
 
+        /* Returns the message of this exception, with the arguments filled in. */
+        inline std::string message() const { return format_message(this->format, this->args.data(), this->args.size()); }
         /* Implementation for std::exception's what() function, so that it's compatible with C++'s uncaught-exception handling. */
-        virtual const char* what() const noexcept { return this->message.c_str(); }
+        virtual const char* what() const noexcept {
+            if (this->formatted.empty()) { this->formatted = this->message(); }
+            return this->formatted.c_str();
+        }
 
         /* Function that prints the error to the given output stream. */
         virtual std::ostream& print(std::ostream& os) const = 0;
@@ -71,10 +165,16 @@ namespace ArgumentParser::Exceptions {
 
     /* Baseclass exception for all non-recoverable errors in the parser. */
     class ADLError : public ADLException {
+    protected:
+        /* Constructor for derived classes that are tied to a position in a file, which takes the location of the error, optionally the template of a message and the arguments to fill in it. */
+        ADLError(const DebugInfo& debug, const char* format, const std::vector<std::string>& args) :
+            ADLException(DiagnosticKind::compile_error, debug, format, args)
+        {}
+
     public:
-        /* Constructor for the ADLError class, which takes the relevant include path of files and optionally a message. */
-        ADLError(const std::vector<std::string>& filenames, const std::string& message = "") :
-            ADLException(filenames, message)
+        /* Constructor for the ADLError class, which takes the relevant include path of files, optionally the template of a message and the arguments to fill in it. */
+        ADLError(const std::vector<std::string>& filenames, const char* format = "", const std::vector<std::string>& args = {}) :
+            ADLException(DiagnosticKind::error, DebugInfo(filenames, 0, 0), format, args)
         {}
 
         /* Function that prints the error to the given output stream. */
@@ -84,21 +184,14 @@ namespace ArgumentParser::Exceptions {
 
     /* Baseclass exception for all non-recoverable errors that are specific to a certain position within a file. */
     class ADLCompileError: public ADLError {
-    private:
-        /* Declare the print function as friend. */
-        friend std::ostream& print_error(std::ostream& os, const ADLError& e);
-
     public:
-        /* The debug information of the token or node that caused this error. */
-        const DebugInfo debug;
-
         /* Constructor for the ADLCompileError class, which takes:
          *   - a DebugInfo struct containing the location in the source file
-         *   - [optional] a message
+         *   - [optional] the template of a message
+         *   - [optional] the arguments to fill in the template
          */
-        ADLCompileError(const DebugInfo& debug, const std::string& message = "") :
-            ADLError(debug.filenames, message),
-            debug(debug)
+        ADLCompileError(const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ADLError(debug, format, args)
         {}
 
         /* Function that prints the compilation error to the given output stream. */
@@ -110,13 +203,20 @@ namespace ArgumentParser::Exceptions {
 
     /* Baseclass exception for all warnings (i.e., extra information about bad practises). */
     class ADLWarning : public ADLException {
+    protected:
+        /* Constructor for derived classes that are tied to a position in a file, which takes the type of warning, the location of the warning, optionally the template of a message and the arguments to fill in it. */
+        ADLWarning(const WarningType type, const DebugInfo& debug, const char* format, const std::vector<std::string>& args) :
+            ADLException(DiagnosticKind::compile_warning, debug, format, args),
+            type(type)
+        {}
+
     public:
         /* The type of this warning. */
         const WarningType type;
 
-        /* Constructor for the ADLWarning class, which takes the type of warning, the relevant include path of files and optionally a message. */
-        ADLWarning(const WarningType type, const std::vector<std::string>& filenames, const std::string& message = "") :
-            ADLException(filenames, message),
+        /* Constructor for the ADLWarning class, which takes the type of warning, the relevant include path of files, optionally the template of a message and the arguments to fill in it. */
+        ADLWarning(const WarningType type, const std::vector<std::string>& filenames, const char* format = "", const std::vector<std::string>& args = {}) :
+            ADLException(DiagnosticKind::warning, DebugInfo(filenames, 0, 0), format, args),
             type(type)
         {}
 
@@ -125,24 +225,17 @@ namespace ArgumentParser::Exceptions {
 
     };
 
-    /* Baseclass exception for all non-recoverable errors that are specific to a certain position within a file. */
+    /* Baseclass exception for all warnings that are specific to a certain position within a file. */
     class ADLCompileWarning: public ADLWarning {
-    private:
-        /* Declare the print function as friend. */
-        friend std::ostream& print_warning(std::ostream& os, const ADLWarning& e);
-
     public:
-        /* The debug information of the token or node that caused this error. */
-        const DebugInfo debug;
-
         /* Constructor for the ADLCompileWarning class, which takes:
          *   - the type of this warning
          *   - a DebugInfo struct containing the location in the source file
-         *   - [optional] a message
+         *   - [optional] the template of a message
+         *   - [optional] the arguments to fill in the template
          */
-        ADLCompileWarning(const WarningType type, const DebugInfo& debug, const std::string& message = "") :
-            ADLWarning(type, debug.filenames, message),
-            debug(debug)
+        ADLCompileWarning(const WarningType type, const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ADLWarning(type, debug, format, args)
         {}
 
         /* Function that prints the compilation warning to the given output stream. */
@@ -155,13 +248,9 @@ namespace ArgumentParser::Exceptions {
     /* Exception that stores additional information to accompany an error or warning. Always references a particular place in a source file. */
     class ADLNote: public ADLException {
     public:
-        /* The debug information of this warning. */
-        const DebugInfo debug;
-
-        /* Constructor for the ADLNote class, which takes a DebugInfo struct to link the location of this error in a source file and a message making the note. */
-        ADLNote(const DebugInfo& debug, const std::string& message) :
-            ADLException(debug.filenames, message),
-            debug(debug)
+        /* Constructor for the ADLNote class, which takes a DebugInfo struct to link the location of this error in a source file, the template of the message making the note and optionally the arguments to fill in it. */
+        ADLNote(const DebugInfo& debug, const char* format, const std::vector<std::string>& args = {}) :
+            ADLException(DiagnosticKind::note, debug, format, args)
         {}
         
         /* Copies the ADLNote polymorphically. */
@@ -174,45 +263,90 @@ namespace ArgumentParser::Exceptions {
 
 
 
+    /* Compact record of a diagnostic logged in an ExceptionHandler. Its arguments are stored in a table in the handler, its include path in the source manager, and its message is only formatted once it's rendered. */
+    struct Diagnostic {
+        /* The kind of diagnostic. */
+        DiagnosticKind kind;
+        /* The number of arguments of the diagnostic. */
+        uint8_t n_args;
+        /* The type of warning, if the diagnostic is one. */
+        WarningType type;
+        /* The location of the diagnostic. */
+        Location location;
+        /* The index of the diagnostic's first argument in the handler's pool of arguments. */
+        uint32_t args;
+        /* The template of the diagnostic's message. */
+        const char* format;
+        /* The number of diagnostics identical to this one (bar their location), on the lines right after it, that were folded into it. */
+        uint32_t repeats;
+    };
+
+
+
     /* Class that is used to group and then neatly print all exceptions and warnings in the ADL compiler. */
     class ExceptionHandler {
     private:
-        /* Pointer to the list of all stored exceptions. */
-        ADLException** exceptions;
-        /* Number of exceptions stored in this handler. */
-        size_t length;
-        /* Maximum number of exception we allocated space for. */
-        size_t max_length;
+        /* The records of all logged diagnostics, in the order they were logged. */
+        std::vector<Diagnostic> diagnostics;
+        /* The arguments of all diagnostics, stored back-to-back. */
+        std::vector<std::string> arguments;
+        /* The ids of the files the diagnostics point to, which the handler retains in the source manager so it can still show their snippets once the tree parsed from them is gone. */
+        std::vector<file_t> sources;
         
         /* Number of errors that have been logged in the handler. */
         size_t n_errors;
-
-        /* Resizes the internal array, by doubling its size. */
-        void resize();
-
-        /* Private function that prints a note to the parser and then throws the given main error. */
-        void add_note(const ADLNote& note);
-        /* Private function that recursively adds extra notes to the parser. */
+        /* Number of warnings that have been logged in the handler (excluding suppressed ones). */
+        size_t n_warnings;
+        /* Number of errors that were left out because there were more than max_errors. */
+        size_t n_omitted_errors;
+        /* Number of warnings that were left out because there were more than max_warnings. */
+        size_t n_omitted_warnings;
+        /* The line on which the last stored diagnostic (or the last repeat folded into it) ended. */
+        size_t repeat_line;
+        /* Number of diagnostics that have already been written by flush(). */
+        size_t n_flushed;
+        /* Number of left-out diagnostics that flush() has already reported. */
+        size_t n_reported_omitted;
+        /* Whether flush() has already reported that the handler is exhausted. */
+        bool reported_exhausted;
+
+        /* The handler that diagnostics logged on this thread go to, if any. */
+        static thread_local ExceptionHandler* active;
+
+        /* Counts the given exception, and returns whether it should be stored. It isn't if it's a suppressed warning, if there are too many of its severity already or if it's folded into the previous diagnostic as a repeat; the latter only happens for exceptions without notes. */
+        bool admit(const ADLException& except, bool has_notes);
+        /* Stores a compact record of the given exception. */
+        void add(const ADLException& except);
+        /* Retains the given file in the source manager, unless the handler already does. */
+        void retain(file_t file);
+        /* Renders the summary of the diagnostics that were left out since the last call to the end of the given buffer, if there is any news. */
+        void render_summary(std::string& buffer);
+
+        /* Private function that adds a single note to the handler. */
+        inline void add_note(const ADLNote& note) { this->add(note); }
+        /* Private function that recursively adds extra notes to the handler. */
         template <class... NOTES>
         void add_note(const ADLNote& note, NOTES... rest) {
-            // Note the note in our internal list, resizing as needed
-            if (this->length >= this->max_length) { this->resize(); }
-            this->exceptions[this->length++] = note.copy();
-    
-            // Don't forget to print it
-            if (this->print_on_add) { note.print(std::cerr); }
+            // Note the note in our internal list
+            this->add(note);
 
             // Add the rest with the rest of the recursion
             this->add_note(rest...);
         }
 
     public:
-        /* Stores whether or not we should print each exception when we add it. */
+        /* Stores whether or not we should print each exception when we add it. If not, the exceptions are only printed by flush(), sorted by location. */
         bool print_on_add;
-        /* Stores all warnings (by their type) that we have suppressed for the toplevel. */
-        WarningType toplevel_suppressed;
-        /* Stores all warnings (by their type) that we have suppressed for the nested, config scope. */
-        WarningType config_suppressed;
+        /* Stores whether or not to print diagnostics with colours. Defaults to whether stderr is a terminal. */
+        bool colour;
+        /* The format in which the diagnostics are written. The structured formats only use the positions of diagnostics, never their source snippets. Since a SARIF log is a single document, that format is best combined with print_on_add turned off and a single flush(). */
+        DiagnosticsFormat output_format;
+        /* The maximum number of errors to store, or 0 for no limit. Once it's reached, the handler is exhausted and the tokenizer and parser stop. */
+        size_t max_errors;
+        /* The maximum number of warnings to store, or 0 for no limit. Warnings over the limit are only counted. */
+        size_t max_warnings;
+        /* Stores all warnings (by their type) that are suppressed everywhere, no matter where they point to. Warnings suppressed with @suppress are looked up in the active SuppressionList instead. */
+        WarningType suppressed_types;
         
         /* Default constructor for the ExceptionHandler class, which optionally takes whether or not exceptions should be printed immediately and the initial size of the internal array. */
         ExceptionHandler(bool print_on_add = true, size_t initial_capacity=4);
@@ -220,64 +354,83 @@ namespace ArgumentParser::Exceptions {
         ExceptionHandler(const ExceptionHandler& other);
         /* Move constructor for the ExceptionHandler class. */
         ExceptionHandler(ExceptionHandler&& other);
-        /* Destructor for the ExceptionHandler class. */
+        /* Destructor for the ExceptionHandler class, which releases the files its diagnostics point to. */
         ~ExceptionHandler();
 
+        /* Returns whether warnings of the given type are suppressed everywhere. */
+        inline bool suppressed(WarningType type) const { return this->suppressed_types & type; }
+        /* Returns whether warnings of the given type are suppressed everywhere or, by the active SuppressionList, at the given position. */
+        bool suppressed(WarningType type, const DebugInfo& at) const;
+
         /* Adds a new exception to the handler. */
         ExceptionHandler& log(const ADLException& except);
         /* Adds a new exception to the handler, which accompanying notes to add to this exception. */
         template <class... NOTES>
         ExceptionHandler& log(const ADLException& except, NOTES... notes) {
-            // If the exception is actually a warning, possibly ignore it
-            if (dynamic_cast<const ADLWarning*>(&except)) {
-                const ADLWarning& warning = (const ADLWarning&) except;
-                #ifdef DEBUG
-                std::cout << "[   Exception   ] Logging warning of type '" << warningtype_names.at(warning.type) << "'" << std::endl;
-                std::cout << "                  Currently suppressed types: " << extract_type_names(this->toplevel_suppressed | this->config_suppressed) << std::endl;
-                #endif
-                if ((this->toplevel_suppressed | this->config_suppressed) & warning.type) {
-                    // It's one of the suppressed types; just return, without doing anything
-                    return *this;
-                }
-            }
+            // If the exception is a suppressed warning or one too many, ignore it (and its notes)
+            if (!this->admit(except, true)) { return *this; }
 
             // Log the exception in our internal list
-            if (this->length >= this->max_length) { this->resize(); }
-            this->exceptions[this->length++] = except.copy();
-            if (dynamic_cast<const ADLError*>(&except)) { ++this->n_errors; }
-    
-            // Don't forget to print it
-            if (this->print_on_add) { except.print(std::cerr); }
+            this->add(except);
 
             // Then, use the notes recursion to add each note
             this->add_note(notes...);
 
+            // Don't forget to print them
+            if (this->print_on_add) { this->flush(std::cerr); }
+
             // When done, return ourselves so we may potentially be thrown
             return *this;
         }
-
-        /* Clears the suppressed types on the toplevel scope. */
-        inline void clear_toplevel() {
-            #ifdef DEBUG
-            std::cout << "[   Exception   ] Cleared suppressed warnings at the toplevel." << std::endl;
-            #endif
-            this->toplevel_suppressed = (WarningType) 0;
-        }
-        /* Clears the suppressed types on the nested, config scope. */
-        inline void clear_config() {
-            #ifdef DEBUG
-            std::cout << "[   Exception   ] Cleared suppressed warnings at the config scope." << std::endl;
-            #endif
-            this->config_suppressed = (WarningType) 0;
+        /* Logs a warning of the given class, constructed with the given DebugInfo and the other given arguments, unless its type is suppressed everywhere or where the DebugInfo points to. Suppressed warnings aren't even constructed. */
+        template <class WARNING, class... ARGS>
+        inline ExceptionHandler& warn(const DebugInfo& debug, ARGS&&... args) {
+            if (this->suppressed(WARNING::warning_type, debug)) { return *this; }
+            return this->log(WARNING(debug, std::forward<ARGS>(args)...));
         }
-        
-        /* Returns a constant reference to the i'th exception in this handler. */
-        inline const ADLException& operator[](size_t i) const { return *(this->exceptions[i]); }
-        /* Returns the number of exceptions currently stored in this handler. */
-        inline size_t size() const { return this->length; }
-        /* Returns the number of errors (not warning) logged in the handler. */
+
+        /* Appends the diagnostics of the given handler to this one, as if they were logged here after everything logged so far. Merging the handlers of separate compilations in a fixed order thus always gives the same result, no matter in which order the compilations finished. */
+        ExceptionHandler& merge(const ExceptionHandler& other);
+
+        /* Returns a constant reference to the record of the i'th diagnostic in this handler. */
+        inline const Diagnostic& operator[](size_t i) const { return this->diagnostics[i]; }
+        /* Returns the number of diagnostics currently stored in this handler. */
+        inline size_t size() const { return this->diagnostics.size(); }
+        /* Returns the number of errors (not warning) logged in the handler, including those that were left out. */
         inline size_t errors() const { return this->n_errors; }
+        /* Returns the number of warnings logged in the handler, including those that were left out but not those that were suppressed. */
+        inline size_t warnings() const { return this->n_warnings; }
+        /* Returns whether the handler has seen as many errors as it may store, after which compilation should stop. */
+        inline bool exhausted() const { return this->max_errors > 0 && this->n_errors >= this->max_errors; }
+
+        /* Returns the message of the given diagnostic, with its arguments filled in. */
+        inline std::string message(const Diagnostic& diagnostic) const { return format_message(diagnostic.format, this->arguments.data() + diagnostic.args, diagnostic.n_args); }
+        /* Renders the given diagnostic to the end of the given buffer. */
+        inline void render(std::string& buffer, const Diagnostic& diagnostic) const { render_diagnostic(buffer, diagnostic.kind, diagnostic.type, diagnostic.location, this->message(diagnostic), this->colour); }
+        /* Renders the diagnostics in the range [first, last) to one string in the output format, sorted by location and with duplicates left out. Notes stay with the diagnostic they accompany. */
+        std::string render(size_t first, size_t last) const;
+        /* Writes all diagnostics that haven't been written yet to the given output stream in one go, sorted by location and with duplicates left out. */
+        std::ostream& flush(std::ostream& os);
         
+        /* Returns the handler that diagnostics logged on this thread go to. If no handler is active, returns the process-wide error_handler. */
+        static ExceptionHandler& current();
+
+        /* The Scope class makes the given handler the active one for as long as it lives, restoring the previous one once it goes out of scope. Giving each compilation (and thus each thread) a handler of its own means they never have to share one. */
+        class Scope {
+        private:
+            /* The handler that was active before this scope. */
+            ExceptionHandler* previous;
+
+        public:
+            /* Constructor for the Scope class, which takes the handler to make active (or a nullptr to use the process-wide one). */
+            Scope(ExceptionHandler* handler) : previous(ExceptionHandler::active) { ExceptionHandler::active = handler; }
+            /* The copy constructor for the Scope class is deleted, as it would restore the previous handler twice. */
+            Scope(const Scope& other) = delete;
+            /* Destructor for the Scope class, which restores the previously active handler. */
+            ~Scope() { ExceptionHandler::active = this->previous; }
+
+        };
+
         /* Neatly prints all exceptions in this ExceptionHandler. */
         friend std::ostream& operator<<(std::ostream& os, const ExceptionHandler& except);
 
@@ -296,16 +449,19 @@ namespace ArgumentParser::Exceptions {
 
 
 
-    /* Static error handler, which can be used to write errors to from the entire parser. */
-    static ExceptionHandler error_handler;
+    /* Process-wide error handler, which is used by every thread that hasn't made a handler of its own active. */
+    inline ExceptionHandler error_handler;
 
 
     
-    /* Shortcut for the handler's log function. */
-    inline ExceptionHandler& log(const ADLException& except) { return error_handler.log(except); }
-    /* Shortcut for the handler's log function (with note support). */
+    /* Shortcut for the log function of the handler active on this thread. */
+    inline ExceptionHandler& log(const ADLException& except) { return ExceptionHandler::current().log(except); }
+    /* Shortcut for the log function of the handler active on this thread (with note support). */
     template <class... NOTES>
-    inline ExceptionHandler& log(const ADLException& except, NOTES... notes) { return error_handler.log(except, notes...); }
+    inline ExceptionHandler& log(const ADLException& except, NOTES... notes) { return ExceptionHandler::current().log(except, notes...); }
+    /* Shortcut for the warn function of the handler active on this thread. */
+    template <class WARNING, class... ARGS>
+    inline ExceptionHandler& warn(const DebugInfo& debug, ARGS&&... args) { return ExceptionHandler::current().warn<WARNING>(debug, std::forward<ARGS>(args)...); }
 
 }
 
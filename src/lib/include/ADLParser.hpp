@@ -4,7 +4,7 @@
  * Created:
  *   11/12/2020, 5:37:52 PM
  * Last edited:
- *   13/12/2020, 14:48:49
+ *   18/10/2026, 17:27:39
  * Auto updated?
  *   Yes
  *
@@ -22,6 +22,8 @@
 #include <string>
 
 #include "ADLExceptions.hpp"
+#include "ADLTokenizer.hpp"
+#include "ADLPreprocessor.hpp"
 #include "ADLTree.hpp"
 
 namespace ArgumentParser {
@@ -31,12 +33,29 @@ namespace ArgumentParser {
         bool toplevel;
     };
 
+    /* Struct that may be passed to parse() to collect some statistics about the run, e.g., for benchmarking. */
+    struct ParseStatistics {
+        /* The number of tokens shifted onto the stack. */
+        size_t shifts;
+        /* The number of grammar rules applied to the stack. */
+        size_t reductions;
+    };
+
 
 
     /* Static "class" that is used to parse a file - and recursively all included files. */
     namespace Parser {
-        /* Parses a single file. Returns a single root node, from which the entire parsed tree is build. Does not immediately throw exceptions, but collects them in a vector which is then thrown. Use std::print_error on each of them to print them neatly. Warnings are always printed by the function, never thrown. */
-        ADLTree* parse(const std::string& filename);
+        /* Callback used by the streaming parse() to hand out each completed toplevel definition, together with a user-defined state. The definition's DebugInfo and configs are available through it. Should return true if the parser may release the definition after the call, or false if it should be kept in the returned tree. */
+        typedef bool (*definition_callback)(ADLDefinition* definition, void* state);
+
+        /* Parses a single file. Returns a single root node, from which the entire parsed tree is build. Does not immediately throw exceptions, but collects them in a vector which is then thrown. Use std::print_error on each of them to print them neatly. Warnings are always printed by the function, never thrown. If statistics is given, it is filled with the number of shifts & reductions done. */
+        ADLTree* parse(const std::string& filename, ParseStatistics* statistics = nullptr);
+        /* Parses a single file in a streaming fashion, calling the given callback (with the given state) as soon as each toplevel definition is reduced. Positionals and Options the callback releases are deallocated immediately, unless a previously emitted definition references them; types and metas are always kept, since they are what other definitions typically reference. Note that references to released arguments from definitions later in the file will thus not resolve. Returns a tree with only the definitions that were kept (which may thus be empty), or a nullptr if parsing failed. */
+        ADLTree* parse(const std::string& filename, definition_callback callback, void* state);
+        /* Parses a single file like the first overload does, except that the root file and all files it includes are opened with the given callback (and its state) instead of read from disk. */
+        ADLTree* parse(const std::string& filename, file_opener opener, void* state);
+        /* Parses a single toplevel definition from the given Tokenizer, which should be positioned at the start of that definition. Stops as soon as one definition has been reduced, and returns it (or a nullptr if the tokens didn't form exactly one definition). Does not run the preprocessor, so any macro encountered also results in a nullptr. */
+        ADLDefinition* parse_definition(Tokenizer& in, const std::string& filename);
     };
     
 }
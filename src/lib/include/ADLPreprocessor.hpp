@@ -4,7 +4,7 @@
  * Created:
  *   03/12/2020, 18:19:27
  * Last edited:
- *   13/12/2020, 15:38:54
+ *   18/10/2026, 19:43:52
  * Auto updated?
  *   Yes
  *
@@ -17,6 +17,7 @@
 #ifndef ADL_PREPROCESSOR_HPP
 #define ADL_PREPROCESSOR_HPP
 
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -29,9 +30,9 @@ namespace ArgumentParser {
         /* Baseclass exception for all Preprocessor-related exceptions. */
         class PreprocessorException: public ADLCompileError {
         public:
-            /* Constructor for the PreprocessorException class, which takes a DebugInfo struct to locate this error in a source file and optionally a message. */
-            PreprocessorException(const DebugInfo& debug, const std::string& message = "") :
-                ADLCompileError(debug, message)
+            /* Constructor for the PreprocessorException class, which takes a DebugInfo struct to locate this error in a source file, optionally the template of a message and the arguments to fill in it. */
+            PreprocessorException(const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+                ADLCompileError(debug, format, args)
             {}
 
         };
@@ -44,7 +45,7 @@ namespace ArgumentParser {
 
             /* Constructor for the UnknownMacroException class, which takes a DebugInfo struct to locate this error in a source file and the unknown macro name. */
             UnknownMacroException(const DebugInfo& debug, const std::string& macro) :
-                PreprocessorException(debug, "Encountered unknown macro '" + macro + "'."),
+                PreprocessorException(debug, "Encountered unknown macro '{0}'.", { macro }),
                 macro(macro)
             {}
 
@@ -64,7 +65,7 @@ namespace ArgumentParser {
 
             /* Constructor for the IllegalMacroValueException class, which takes a DebugInfo struct to locate this error in a source file, a macro name where the error occurred, the name of the given type and the name(s) of the type(s) we expected. */
             IllegalMacroValueException(const DebugInfo& debug, const std::string& macro_name, const std::string& given_type, const std::string& expected_type = "") :
-                PreprocessorException(debug, macro_name + "-macro can't be followed up by a " + given_type + (!expected_type.empty() ? (" (expected " + expected_type + ").") : ".")),
+                PreprocessorException(debug, !expected_type.empty() ? "{0}-macro can't be followed up by a {1} (expected {2})." : "{0}-macro can't be followed up by a {1}.", { macro_name, given_type, expected_type }),
                 macro(macro_name),
                 given(given_type),
                 expected(expected_type)
@@ -79,7 +80,7 @@ namespace ArgumentParser {
         public:
             /* Constructor for the IllegalSysFileException class, which takes a DebugInfo struct linking this error to the source, the system file that was attempted to be included and a string describing those that can be included. */
             IllegalSysFileException(const DebugInfo& debug, const std::string& given, const std::string& expected) :
-                PreprocessorException(debug, "Unknown system file '" + given + "' (this compiler only knows " + expected + ").")
+                PreprocessorException(debug, "Unknown system file '{0}' (this compiler only knows {1}).", { given, expected })
             {}
 
             /* Copies the IllegalSysFileException polymorphically. */
@@ -130,7 +131,7 @@ namespace ArgumentParser {
 
             /* Constructor for the EmptyConditionException class, which takes a DebugInfo struct to locate this error in a source file and a macro name where the error occurred. */
             EmptyConditionException(const DebugInfo& debug, const std::string& macro_name) :
-                PreprocessorException(debug, "Encountered " + macro_name + "-macro without define to check for."),
+                PreprocessorException(debug, "Encountered {0}-macro without define to check for.", { macro_name }),
                 macro(macro_name)
             {}
 
@@ -144,9 +145,9 @@ namespace ArgumentParser {
         /* Baseclass for all the preprocessor warnings. */
         class PreprocessorWarning: public ADLCompileWarning {
         public:
-            /* Constructor for the PreprocessorWarning class, which takes the warning type, a DebugInfo struct to locate this error in a source file and optionally a message. */
-            PreprocessorWarning(WarningType type, const DebugInfo& debug, const std::string& message = "") :
-                ADLCompileWarning(type, debug, message)
+            /* Constructor for the PreprocessorWarning class, which takes the warning type, a DebugInfo struct to locate this error in a source file, optionally the template of a message and the arguments to fill in it. */
+            PreprocessorWarning(WarningType type, const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+                ADLCompileWarning(type, debug, format, args)
             {}
 
         };
@@ -154,9 +155,12 @@ namespace ArgumentParser {
         /* Warning for when a variable is defined twice. */
         class DuplicateDefineWarning: public PreprocessorWarning {
         public:
+            /* The type of this warning. */
+            static constexpr WarningType warning_type = WarningType::duplicate_define;
+
             /* Constructor for the DuplicateDefineWarning class, which takes a DebugInfo struct to link this error to a source file and the define that was a duplicate. */
             DuplicateDefineWarning(const DebugInfo& debug, const std::string& define) :
-                PreprocessorWarning(WarningType::duplicate_define, debug, "Define '" + define + "' is already defined.")
+                PreprocessorWarning(warning_type, debug, "Define '{0}' is already defined.", { define })
             {}
 
             /* Copies the DuplicateDefineWarning polymorphically. */
@@ -166,9 +170,12 @@ namespace ArgumentParser {
         /* Warning for when a define was attempted to be undefined, but it was never defined in the first place. */
         class MissingDefineWarning: public PreprocessorWarning {
         public:
+            /* The type of this warning. */
+            static constexpr WarningType warning_type = WarningType::missing_define;
+
             /* Constructor for the MissingDefineWarning class, which takes a DebugInfo struct to link this error to a source file and the define that was missing. */
             MissingDefineWarning(const DebugInfo& debug, const std::string& define) :
-                PreprocessorWarning(WarningType::missing_define, debug, "Define '" + define + "' is not defined.")
+                PreprocessorWarning(warning_type, debug, "Define '{0}' is not defined.", { define })
             {}
 
             /* Copies the MissingDefineWarning polymorphically. */
@@ -180,9 +187,16 @@ namespace ArgumentParser {
 
 
 
+    /* Callback used by the Preprocessor to open the root file and each file it includes, given its path and a user-defined state. Should return a newly allocated stream at the start of the file, which the Preprocessor takes ownership of, or an std::ifstream that isn't open if there is no such file. */
+    typedef std::istream* (*file_opener)(const std::string& path, void* state);
+
     /* The Preprocessor class is used to wrap around the ADLTokenizer and process things like includes and conditional compilation. */
     class Preprocessor {
     private:
+        /* The callback used to open files, or a nullptr to read them from disk. */
+        file_opener opener;
+        /* The state passed to the opener. */
+        void* opener_state;
         /* Reference to the current tokenizer. */
         Tokenizer* current;
         /* Place to store all internal Tokenizers, one per open file. */
@@ -196,6 +210,8 @@ namespace ArgumentParser {
         bool done_tokenizing;
         /* Keeps track of all the paths we seen so far. */
         std::vector<std::string> included_paths;
+        /* The ids of all files opened so far, whose contents the source manager keeps for as long as the Preprocessor lives. */
+        std::vector<file_t> files;
         /* Keeps track of all defines currently present. */
         std::vector<std::string> defines;
         /* Keeps track of how many compileable and unclosed ifdefs we saw. */
@@ -203,8 +219,12 @@ namespace ArgumentParser {
         /* List of all previously defined ifdefs for each file in the include tree. */
         std::vector<std::vector<std::tuple<std::string, DebugInfo>>> ifdefs_stack;
         
+        /* Opens the file at the given path with the opener, or from disk if there is none. */
+        std::istream* open(const std::string& path);
         /* Resizes the internal tokenizers list by doubling its size. */
         void resize();
+        /* Keeps the contents of the file read by the given (new) tokenizer around after the tokenizer is done with it. */
+        void retain(const Tokenizer* tokenizer);
         /* Used internally to get any tokens from the combined input stream. */
         Token* read_head(bool pop);
         /* Used to check if a given vector of strings contains the given string. */
@@ -226,8 +246,8 @@ namespace ArgumentParser {
         Token* endif_handler(bool pop, Token* token);
 
     public:
-        /* Constructor for the Preprocessor class, which takes a filename to open and a vector containing all the defines from the CLI. */
-        Preprocessor(const std::string& filename, const std::vector<std::string>& defines);
+        /* Constructor for the Preprocessor class, which takes a filename to open, a vector containing all the defines from the CLI and optionally a callback (with its state) to open the files with instead of reading them from disk. */
+        Preprocessor(const std::string& filename, const std::vector<std::string>& defines, file_opener opener = nullptr, void* opener_state = nullptr);
         /* Copy constructor for the Preprocessor class, which is deleted, since we can't copy Tokenizers either */
         Preprocessor(const Preprocessor& other) = delete;
         /* Move constructor for the Preprocessor class. */
@@ -249,6 +269,8 @@ namespace ArgumentParser {
 
         /* Returns the current trail of breadcrumbs. */
         inline const std::vector<std::string>& breadcrumbs() const { return this->current->filenames; }
+        /* Returns the ids (in the source manager) of all files opened so far, so whoever keeps what was parsed from them can retain them too. */
+        inline const std::vector<file_t>& sources() const { return this->files; }
 
         /* Returns true if an end-of-file has been reached. */
         inline bool eof() const { return this->done_tokenizing; }
@@ -4,7 +4,7 @@
  * Created:
  *   10/12/2020, 14:43:50
  * Last edited:
- *   11/02/2021, 16:39:02
+ *   18/10/2026, 14:39:12
  * Auto updated?
  *   Yes
  *
@@ -17,6 +17,7 @@
 #define ADLSYMBOL_TABLE_HPP
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <ostream>
@@ -45,6 +46,15 @@ namespace ArgumentParser {
     private:
         /* Vector which lists all the ids given in this symbol table, in an ordered fashion. */
         std::vector<SymbolTableEntry> entries;
+        /* Index from the hash of each raw id to the first entry with that raw id, so lookups don't have to scan the entries. */
+        std::unordered_multimap<size_t, size_t> index;
+
+        /* Adds the entry at the given position to the index, unless an earlier entry already has the same raw id. */
+        void index_entry(size_t i);
+        /* Rebuilds the index from scratch, which is needed after entries have moved. */
+        void reindex();
+        /* Returns the position of the first entry with the given raw id, or the size of the table if there is none. */
+        size_t lookup(const std::string_view& raw_id) const;
 
     public:
         /* Default constructor for the SymbolTable class. */
@@ -60,6 +70,11 @@ namespace ArgumentParser {
         /* Returns whether or not a symbol with the given id exists. */
         bool contains(const std::string& id) const;
 
+        /* Returns a pointer to the symbol table entry with the given identifier, or a nullptr if it's not present. */
+        SymbolTableEntry* find(const std::string& id);
+        /* Returns a constant pointer to the symbol table entry with the given identifier, or a nullptr if it's not present. */
+        const SymbolTableEntry* find(const std::string& id) const;
+
         /* Returns a muteable reference to the symbol table entry with the given identifier. Might throw errors if not present. */
         SymbolTableEntry& at(const std::string& id);
         /* Returns a constant reference to the symbol table entry with the given identifier. Might throw errors if not present. */
@@ -4,7 +4,7 @@
  * Created:
  *   05/11/2020, 16:17:58
  * Last edited:
- *   2/9/2021, 3:50:19 PM
+ *   18/10/2026, 20:04:03
  * Auto updated?
  *   Yes
  *
@@ -26,6 +26,7 @@
 #include <limits>
 
 #include "DebugInfo.hpp"
+#include "SourceManager.hpp"
 #include "ADLExceptions.hpp"
 #include "TokenTypes.hpp"
 
@@ -35,8 +36,8 @@ namespace ArgumentParser {
         class TokenizeError : public ADLError {
         public:
             /* Constructor for the TokenizeError class, which takes a list of files we tried to parse (breadcrumb-style), the line number where the error occurred, the column number, the actual, optionally a message and optionally a pretty message. */
-            TokenizeError(const std::vector<std::string>& filenames, const std::string& message = "") :
-                ADLError(filenames, message)
+            TokenizeError(const std::vector<std::string>& filenames, const char* format = "", const std::vector<std::string>& args = {}) :
+                ADLError(filenames, format, args)
             {}
 
         };
@@ -47,9 +48,9 @@ namespace ArgumentParser {
             /* Error number that occurred. */
             const int err_no;
 
-            /* Constructor for the IOError class, which takes the name of the file that we tried to open, the errno that occured and optionally a message. */
-            IOError(const std::vector<std::string>& filenames, const int err_no, const std::string& message = "") :
-                TokenizeError(filenames, message),
+            /* Constructor for the IOError class, which takes the name of the file that we tried to open, the errno that occured, optionally the template of a message and the arguments to fill in it. */
+            IOError(const std::vector<std::string>& filenames, const int err_no, const char* format = "", const std::vector<std::string>& args = {}) :
+                TokenizeError(filenames, format, args),
                 err_no(err_no)
             {}
 
@@ -62,7 +63,7 @@ namespace ArgumentParser {
         public:
             /* Constructor for the FileOpenError class, which takes the name of the file that we tried to open and the errno that occured. */
             FileOpenError(const std::vector<std::string>& filenames, const int err_no) :
-                IOError(filenames, err_no, "Could not open file: " + std::string(std::strerror(err_no)))
+                IOError(filenames, err_no, "Could not open file: {0}", { std::strerror(err_no) })
             {}
 
             /* Copies the FileOpenError polymorphically. */
@@ -74,7 +75,7 @@ namespace ArgumentParser {
         public:
             /* Constructor for the FileReadError class, which takes the name of the file that we tried to open and the errno that occured. */
             FileReadError(const std::vector<std::string>& filenames, const int err_no) :
-                IOError(filenames, err_no, "Could not read from file: " + std::string(std::strerror(err_no)))
+                IOError(filenames, err_no, "Could not read from file: {0}", { std::strerror(err_no) })
             {}
 
             /* Copies the FileReadError polymorphically. */
@@ -89,8 +90,8 @@ namespace ArgumentParser {
              *   - a DebugInfo struct linking this exception to a place in the source file
              *   - [optional] a message
              */
-            SyntaxError(const DebugInfo& debug, const std::string& message = "") :
-                ADLCompileError(debug, message)
+            SyntaxError(const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+                ADLCompileError(debug, format, args)
             {}
 
         };
@@ -102,7 +103,7 @@ namespace ArgumentParser {
 
             /* Constructor for the UnexpectedCharException, which takes a DebugInfo struct linking this exception to a place in the source file and the illegal character itself. */
             UnexpectedCharException(const DebugInfo& debug, const char c) :
-                SyntaxError(debug, (std::string("Unexpected character '") += c) + "'."),
+                SyntaxError(debug, "Unexpected character '{0}'.", { std::string(1, c) }),
                 c(c)
             {}
 
@@ -130,7 +131,7 @@ namespace ArgumentParser {
 
             /* Constructor for the IllegalShortlabelException class, which takes a DebugInfo struct linking this exception to a place in the source file and the illegal character itself. */
             IllegalShortlabelException(const DebugInfo& debug, const char c) :
-                SyntaxError(debug, (std::string("Encountered illegal character '") += c) + "' for shortlabel."),
+                SyntaxError(debug, "Encountered illegal character '{0}' for shortlabel.", { std::string(1, c) }),
                 c(c)
             {}
 
@@ -158,7 +159,7 @@ namespace ArgumentParser {
 
             /* Constructor for the IllegalLonglabelException class, which takes a DebugInfo struct linking this exception to a place in the source file and the illegal character itself. */
             IllegalLonglabelException(const DebugInfo& debug, const char c) :
-                SyntaxError(debug, (std::string("Encountered illegal character '") += c) + "' for longlabel."),
+                SyntaxError(debug, "Encountered illegal character '{0}' for longlabel.", { std::string(1, c) }),
                 c(c)
             {}
 
@@ -186,7 +187,7 @@ namespace ArgumentParser {
 
             /* Constructor for the IllegalNegativeException class, which takes a DebugInfo struct linking this exception to a place in the source file and the illegal character itself. */
             IllegalNegativeException(const DebugInfo& debug, const char c) :
-                SyntaxError(debug, (std::string("Encountered non-numeric character '") += c) + "' while parsing a numeric value."),
+                SyntaxError(debug, "Encountered non-numeric character '{0}' while parsing a numeric value.", { std::string(1, c) }),
                 c(c)
             {}
 
@@ -214,7 +215,7 @@ namespace ArgumentParser {
 
             /* Constructor for the IllegalTypeException class, which takes a DebugInfo struct linking this exception to a place in the source file and the illegal character itself. */
             IllegalTypeException(const DebugInfo& debug, const char c) :
-                SyntaxError(debug, (std::string("Encountered illegal character '") += c) + "' for a type identifier."),
+                SyntaxError(debug, "Encountered illegal character '{0}' for a type identifier.", { std::string(1, c) }),
                 c(c)
             {}
 
@@ -242,7 +243,7 @@ namespace ArgumentParser {
 
             /* Constructor for the IllegalBooleanException class, which takes a DebugInfo struct linking this exception to a place in the source file and the string that was given instead. */
             IllegalBooleanException(const DebugInfo& debug, const std::string& value) :
-                SyntaxError(debug, "Encountered illegal boolean value '" + value + "' (expected 'true' or 'false' only)."),
+                SyntaxError(debug, "Encountered illegal boolean value '{0}' (expected 'true' or 'false' only).", { value }),
                 value(value)
             {}
   
@@ -254,7 +255,7 @@ namespace ArgumentParser {
         class IllegalStringException: public SyntaxError {
         private:
             /* Possible beautifies the illegal character somewhat. */
-            std::string make_readable(char c) const {
+            static std::string make_readable(char c) {
                 if (c == '\n') { return "\\n"; }
                 else if (c == '\r') { return "\\r"; }
                 else if (c == '\t') { return "\\t"; }
@@ -267,7 +268,7 @@ namespace ArgumentParser {
 
             /* Constructor for the IllegalStringException class, which takes a DebugInfo struct linking this exception to a place in the source file and the illegal character itself. */
             IllegalStringException(const DebugInfo& debug, const char c) :
-                SyntaxError(debug, "Encountered non-readable character '" + this->make_readable(c) + "' while parsing string."),
+                SyntaxError(debug, "Encountered non-readable character '{0}' while parsing string.", { make_readable(c) }),
                 c(c)
             {}
 
@@ -335,6 +336,18 @@ namespace ArgumentParser {
             /* Copies the UnterminatedBooleanException polymorphically. */
             virtual UnterminatedBooleanException* copy() const { return new UnterminatedBooleanException(*this); }
 
+        };
+        /* Exception for when an integral constant doesn't fit in a long. */
+        class IntegerTooLargeException: public SyntaxError {
+        public:
+            /* Constructor for the IntegerTooLargeException class, which takes a DebugInfo struct linking this exception to a place in the source file. */
+            IntegerTooLargeException(const DebugInfo& debug) :
+                SyntaxError(debug, "Integral constant too large (it should lie between {0} and {1}).", { std::to_string(std::numeric_limits<long>::min()), std::to_string(std::numeric_limits<long>::max()) })
+            {}
+
+            /* Copies the IntegerTooLargeException polymorphically. */
+            virtual IntegerTooLargeException* copy() const { return new IntegerTooLargeException(*this); }
+
         };
         /* Exception for when a multi-line comment is unterminated. Contains a nested exception that contains an extra note. */
         class UnterminatedMultilineException: public SyntaxError {
@@ -348,24 +361,39 @@ namespace ArgumentParser {
             virtual UnterminatedMultilineException* copy() const { return new UnterminatedMultilineException(*this); }
 
         };
+        /* Exception for when a code snippet is unterminated. Contains a nested exception that contains an extra note. */
+        class UnterminatedSnippetException: public SyntaxError {
+        public:
+            /* Constructor for the UnterminatedSnippetException class, which only takes a DebugInfo struct linking this exception to a place in the source file. */
+            UnterminatedSnippetException(const DebugInfo& debug) :
+                SyntaxError(debug, "Unterminated code snippet encountered.")
+            {}
+
+            /* Copies the UnterminatedSnippetException polymorphically. */
+            virtual UnterminatedSnippetException* copy() const { return new UnterminatedSnippetException(*this); }
+
+        };
 
 
 
         /* Baseclass exception for when a value goes out of the allowed range. */
         class OutOfRangeWarning: public ADLCompileWarning {
         public:
-            /* Constructor for the OutOfRangeError class, which takes the subtype of the derived class, debugging information and optionally a message. */
-            OutOfRangeWarning(WarningType type, const DebugInfo& debug, const std::string& message = "") :
-                ADLCompileWarning(type, debug, message)
+            /* Constructor for the OutOfRangeError class, which takes the subtype of the derived class, debugging information, optionally the template of a message and the arguments to fill in it. */
+            OutOfRangeWarning(WarningType type, const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+                ADLCompileWarning(type, debug, format, args)
             {}
 
         };
         /* Exception that is thrown when a given number overflows (i.e., it's larger than T::max()). */
         class OverflowWarning: public OutOfRangeWarning {
         public:
+            /* The type of this warning. */
+            static constexpr WarningType warning_type = WarningType::int_overflow;
+
             /* Constructor for the OverflowWarning class, which only takes debugging information that links this error to a location in a source file. */
             OverflowWarning(const DebugInfo& debug) :
-                OutOfRangeWarning(WarningType::int_overflow, debug, "Overflow of integral constant (larger than " + std::to_string(std::numeric_limits<long>::max()) + ")")
+                OutOfRangeWarning(warning_type, debug, "Overflow of integral constant (larger than {0})", { std::to_string(std::numeric_limits<long>::max()) })
             {}
 
             /* Copies the OverflowWarning polymorphically. */
@@ -375,9 +403,12 @@ namespace ArgumentParser {
         /* Exception that is thrown when a given floating-point number overflows. */
         class FloatOverflowWarning: public OutOfRangeWarning {
         public:
+            /* The type of this warning. */
+            static constexpr WarningType warning_type = WarningType::float_overflow;
+
             /* Constructor for the FloatOverflowWarning class, which only takes debugging information that links this error to a location in a source file. */
             FloatOverflowWarning(const DebugInfo& debug) :
-                OutOfRangeWarning(WarningType::float_overflow, debug, "Overflow of decimal constant (larger than " + std::to_string(std::numeric_limits<double>::max()) + ")")
+                OutOfRangeWarning(warning_type, debug, "Overflow of decimal constant (larger than {0})", { std::to_string(std::numeric_limits<double>::max()) })
             {}
 
             /* Copies the FloatOverflowWarning polymorphically. */
@@ -387,9 +418,12 @@ namespace ArgumentParser {
         /* Exception that is thrown when a given number underflows (i.e., it's smaller than T::min()). */
         class UnderflowWarning: public OutOfRangeWarning {
         public:
+            /* The type of this warning. */
+            static constexpr WarningType warning_type = WarningType::int_underflow;
+
             /* Constructor for the UnderflowWarning class, which only takes debugging information that links this error to a location in a source file. */
             UnderflowWarning(const DebugInfo& debug) :
-                OutOfRangeWarning(WarningType::int_underflow, debug, "Underflow of integral constant (smaller than " + std::to_string(std::numeric_limits<long>::min()) + ")")
+                OutOfRangeWarning(warning_type, debug, "Underflow of integral constant (smaller than {0})", { std::to_string(std::numeric_limits<long>::min()) })
             {}
 
             /* Copies the UnderflowWarning polymorphically. */
@@ -446,7 +480,7 @@ namespace ArgumentParser {
 
     };
 
-    /* Derived ValueToken class, which can store an already parsed, non-string value. */
+    /* Derived ValueToken class, which can store an already parsed, non-string value. References are stored as ValueToken<size_t>, where the value is the position of the dot in the raw value. */
     template <class T>
     class ValueToken : public Token {
     private:
@@ -460,7 +494,7 @@ namespace ArgumentParser {
         /* Default constructor for the ValueToken class. */
         ValueToken() {}
         
-        /* "Promotes" an existing Token to a ValueToken, by copying it and adding our value. Note that the given token will be deallocated. */
+        /* "Promotes" an existing Token to a ValueToken, by moving its properties and adding our value. Note that the given token will be deallocated. */
         static ValueToken<T>* promote(Token* other, const T& value);
 
         /* Allows the ValueToken to be copied polymorphically. */
@@ -485,8 +519,6 @@ namespace ArgumentParser {
         size_t line;
         /* Counter used internall over the column numbers. */
         size_t col;
-        /* The last position in the internal file where a newline was encountered. */
-        long last_newline;
         /* If set to true, will not tokenize any further. */
         bool done_tokenizing;
 
@@ -495,17 +527,19 @@ namespace ArgumentParser {
 
         /* Used internally to read the first token off the stream. */
         Token* read_head();
-        /* Reads the entire, current line from the internal file. */
-        LineSnippet get_line();
 
     public:
         /* The breadcrumbs of included files. */
         std::vector<std::string> filenames;
         /* The path we are currently parsing. */
         const std::string path;
+        /* The id of the file in the source manager, which keeps its contents for as long as the Tokenizer lives, or SourceManager::none if the stream couldn't be read twice. */
+        file_t source;
 
         /* Constructor for the Tokenizer class, which takes an input stream and a path of file breadcrumbs telling the Tokenizer from where it's reading. */
         Tokenizer(std::istream* stream, const std::vector<std::string>& filenames);
+        /* Constructor for the Tokenizer class, which takes an input stream that is already positioned somewhere in a file, a path of file breadcrumbs and the line & column number that position corresponds to. Used to tokenize only a part of a file. */
+        Tokenizer(std::istream* stream, const std::vector<std::string>& filenames, size_t line, size_t col);
         /* The copy constructor for the Tokenizer class has been deleted, as it makes no sense to copy a stream (which the Tokenizer pretends to be). */
         Tokenizer(const Tokenizer& other) = delete;
         /* Move constructor for the Tokenizer class. */
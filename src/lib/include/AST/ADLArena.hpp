@@ -0,0 +1,122 @@
+/* ADLARENA.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:04:12
+ * Last edited:
+ *   18/10/2026, 14:12:01
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the ADLArena class, which is a simple bump allocator that
+ *   owns the memory of all nodes of a single ADLTree. Nodes allocated in
+ *   an arena are not freed one-by-one; instead, all of their memory is
+ *   released in bulk once the arena itself is destroyed. Also contains
+ *   an allocator that can be used to let std-containers (like the
+ *   children of an ADLBranch) allocate in an arena.
+**/
+
+#ifndef ADL_ARENA_HPP
+#define ADL_ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ArgumentParser {
+    /* The ADLArena class is a bump allocator that owns the memory of all nodes of a single ADLTree, releasing it in bulk when it is destroyed. */
+    class ADLArena {
+    private:
+        /* The blocks of memory allocated so far. */
+        std::vector<char*> blocks;
+        /* Pointer to the next free byte in the current block. */
+        char* head;
+        /* The number of bytes left in the current block. */
+        size_t left;
+        /* The total number of bytes handed out by this arena. */
+        size_t n_bytes;
+
+        /* The arena in which nodes are currently allocated on this thread, if any. */
+        static thread_local ADLArena* active;
+
+    public:
+        /* The size of each block of memory allocated by the arena. Allocations larger than this get a block of their own. */
+        static constexpr size_t block_size = 64 * 1024;
+        /* The alignment of every allocation in the arena. */
+        static constexpr size_t alignment = alignof(std::max_align_t);
+
+
+        /* Default constructor for the ADLArena class. */
+        ADLArena();
+        /* The copy constructor for the ADLArena class is deleted, as copying its memory would make no sense. */
+        ADLArena(const ADLArena& other) = delete;
+        /* Destructor for the ADLArena class, which releases all memory allocated in it. */
+        ~ADLArena();
+
+        /* Allocates the given number of bytes in the arena. The memory stays valid until the arena is destroyed. */
+        void* allocate(size_t n);
+        /* Returns the total number of bytes handed out by this arena. */
+        inline size_t size() const { return this->n_bytes; }
+
+        /* Returns the arena in which nodes are currently allocated on this thread, or a nullptr if they are allocated on the heap. */
+        inline static ADLArena* current() { return ADLArena::active; }
+
+        /* The Scope class makes the given arena the active one for as long as it lives, restoring the previous one once it goes out of scope. */
+        class Scope {
+        private:
+            /* The arena that was active before this scope. */
+            ADLArena* previous;
+
+        public:
+            /* Constructor for the Scope class, which takes the arena to make active (or a nullptr to allocate on the heap). */
+            Scope(ADLArena* arena) : previous(ADLArena::active) { ADLArena::active = arena; }
+            /* The copy constructor for the Scope class is deleted, as it would restore the previous arena twice. */
+            Scope(const Scope& other) = delete;
+            /* Destructor for the Scope class, which restores the previously active arena. */
+            ~Scope() { ADLArena::active = this->previous; }
+
+        };
+
+    };
+
+
+
+    /* Allocator that lets std-containers allocate in an ADLArena, or on the heap if no arena is given. Memory in an arena is never freed individually. */
+    template <class T>
+    class ArenaAllocator {
+    public:
+        /* The type of values we allocate. */
+        using value_type = T;
+
+        /* The arena we allocate in, or a nullptr for the heap. */
+        ADLArena* arena;
+
+
+        /* Constructor for the ArenaAllocator class, which takes the arena to allocate in (or a nullptr to allocate on the heap). */
+        ArenaAllocator(ADLArena* arena = nullptr) : arena(arena) {}
+        /* Converting constructor for the ArenaAllocator class, as required by std-containers. */
+        template <class U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+        /* Allocates space for n values. */
+        inline T* allocate(size_t n) {
+            if (this->arena != nullptr) { return (T*) this->arena->allocate(n * sizeof(T)); }
+            return (T*) ::operator new(n * sizeof(T));
+        }
+        /* Deallocates the given space, which does nothing if it lives in an arena. */
+        inline void deallocate(T* ptr, size_t) {
+            if (this->arena == nullptr) { ::operator delete(ptr); }
+        }
+
+        /* Two allocators are equal if they allocate in the same place. */
+        template <class U>
+        inline bool operator==(const ArenaAllocator<U>& other) const { return this->arena == other.arena; }
+        /* Two allocators are unequal if they allocate in different places. */
+        template <class U>
+        inline bool operator!=(const ArenaAllocator<U>& other) const { return this->arena != other.arena; }
+
+    };
+}
+
+#endif
@@ -4,7 +4,7 @@
  * Created:
  *   26/11/2020, 11:36:56
  * Last edited:
- *   11/02/2021, 16:23:24
+ *   18/10/2026, 19:23:05
  * Auto updated?
  *   Yes
  *
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "ADLArena.hpp"
 #include "ADLNode.hpp"
 #include "NodeType.hpp"
 #include "WarningTypes.hpp"
@@ -28,6 +29,10 @@
 namespace ArgumentParser {
     /* The ADLBranch class forms the baseclass for all nodes with children in the AST, centralizing memory management and traversal. */
     class ADLBranch: public ADLNode {
+    protected:
+        /* Lets derived classes that keep pointers to some of their children point them to the given new node if they pointed to the given old one. Called whenever a child is replaced, before the old one is released. Does nothing by default. */
+        virtual void rebind(ADLNode* old_node, ADLNode* new_node);
+
     public:
         /* Indicates whether or not the number of children is bounded. */
         bool has_max;
@@ -35,15 +40,18 @@ namespace ArgumentParser {
         size_t max;
         /* Lists the allowed children types of this node. */
         NodeType whitelist;
-        /* Contains all children of this node. */
-        std::vector<ADLNode*> children;
+        /* Contains all children of this node. Lives in the same ADLArena as the node itself, if any. */
+        std::vector<ADLNode*, ArenaAllocator<ADLNode*>> children;
+
+        /* Whether the traversal on this thread is currently somewhere below a branch that is shared between trees. Replacing a child there copies the branch (and so the path up to the first unshared one) instead of changing it in-place. */
+        static thread_local bool in_shared;
 
 
         /* Constructor for the ADLBranch class, which takes the type of the derived node, a DebugInfo struct linking this node to a location in the source file and optionally a NodeType denoting all accepted children types. */
         ADLBranch(NodeType type, const DebugInfo& debug, NodeType whitelist = nt_all);
         /* Constructor for the ADLBranch class, which takes the type of the derived node, a DebugInfo struct linking this node to a location in the source file, the maximum number of children to allow and optionally a NodeType denoting all accepted children types. */
         ADLBranch(NodeType type, const DebugInfo& debug, size_t max, NodeType whitelist = nt_all);
-        /* Copy constructor for the ADLBranch class. */
+        /* Copy constructor for the ADLBranch class, which shares the children with the other branch instead of copying them. The parent of the shared children keeps pointing to the other branch. */
         ADLBranch(const ADLBranch& other);
         /* Move constructor for the ADLBranch class. */
         ADLBranch(ADLBranch&& other);
@@ -52,6 +60,8 @@ namespace ArgumentParser {
 
         /* Adds a node as child of this node. */
         virtual void add_node(ADLNode* node);
+        /* Replaces the child at the given index with the given node, releasing the old one. Derived classes that keep pointers to their children are told through rebind(). */
+        void replace_child(size_t index, ADLNode* node);
         /* Returns a node as a given type. */
         template <class T, typename = std::enable_if_t<std::is_base_of<ADLNode, T>::value> >
         inline T* get_node(size_t index) const { return (T*) this->children[index]; }
@@ -61,10 +71,26 @@ namespace ArgumentParser {
         /* Returns the number of children currently in this node. */
         inline size_t size() const { return this->children.size(); }
 
-        /* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-        virtual void traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*));
-        /* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-        virtual void traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state);
+        /* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Returns the node to use in place of this one, which is a copy if this node is shared and one of its children was replaced. */
+        virtual ADLNode* traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*));
+        /* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Returns the node to use in place of this one, which is a copy if this node is shared and one of its children was replaced. */
+        virtual ADLNode* traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state);
+
+        /* The SharedScope class marks everything below the given branch as shared if the branch itself is, restoring the previous value once it goes out of scope. */
+        class SharedScope {
+        private:
+            /* Whether we were already below a shared branch. */
+            bool previous;
+
+        public:
+            /* Constructor for the SharedScope class, which takes the branch we're about to recurse into. */
+            SharedScope(const ADLBranch* branch) : previous(ADLBranch::in_shared) { ADLBranch::in_shared = this->previous || branch->refs > 1; }
+            /* The copy constructor for the SharedScope class is deleted, as it would restore the previous value twice. */
+            SharedScope(const SharedScope& other) = delete;
+            /* Destructor for the SharedScope class, which restores the previous value. */
+            ~SharedScope() { ADLBranch::in_shared = this->previous; }
+
+        };
 
     };
 }
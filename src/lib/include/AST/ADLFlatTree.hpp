@@ -0,0 +1,59 @@
+/* ADLFLAT TREE.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:22:31
+ * Last edited:
+ *   18/10/2026, 14:25:48
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the ADLFlatTree class, which is a flattened view on a parsed
+ *   AST. The nodes are stored in pre-order in a set of parallel arrays
+ *   (their types, parents, first children, next siblings and the nodes
+ *   themselves), so that passes that only need the tree's structure can
+ *   stream through it linearly instead of chasing pointers.
+**/
+
+#ifndef ADL_FLAT_TREE_HPP
+#define ADL_FLAT_TREE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "ADLNode.hpp"
+#include "NodeType.hpp"
+
+namespace ArgumentParser {
+    /* The ADLFlatTree class stores the structure of an AST in pre-order as a set of parallel arrays, indexed by the nodes' position in that order. */
+    class ADLFlatTree {
+    public:
+        /* Value used for indices that point to no node (e.g., the parent of the root). */
+        static constexpr uint32_t none = UINT32_MAX;
+
+        /* The type of each node. */
+        std::vector<NodeType> types;
+        /* The index of the parent of each node, or ADLFlatTree::none for the root. */
+        std::vector<uint32_t> parents;
+        /* The index of the first child of each node, or ADLFlatTree::none if it has none. */
+        std::vector<uint32_t> first_children;
+        /* The index of the next sibling of each node, or ADLFlatTree::none if it's the last child of its parent. */
+        std::vector<uint32_t> next_siblings;
+        /* The node that each index refers to, for when the payload of a node is needed. */
+        std::vector<ADLNode*> nodes;
+
+
+        /* Constructor for the ADLFlatTree class, which flattens the (sub)tree rooted at the given node. Note that the flat tree refers to the nodes, so it is only valid for as long as the tree is not changed. */
+        ADLFlatTree(ADLNode* root);
+
+        /* Returns the number of nodes in the flat tree. */
+        inline size_t size() const { return this->types.size(); }
+        /* Returns the node at the given index as the given type. */
+        template <class T, typename = std::enable_if_t<std::is_base_of<ADLNode, T>::value> >
+        inline T* get_node(size_t index) const { return (T*) this->nodes[index]; }
+
+    };
+}
+
+#endif
@@ -0,0 +1,91 @@
+/* ADLINTERN TABLE.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:43:52
+ * Last edited:
+ *   18/10/2026, 19:55:11
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the InternTable class, which stores each distinct identifier,
+ *   label, property name or type name of a compilation only once. Each
+ *   string is given a 32-bit id, so that nodes can compare them as
+ *   integers instead of as strings.
+**/
+
+#ifndef ADL_INTERN_TABLE_HPP
+#define ADL_INTERN_TABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ArgumentParser {
+    /* The type of the ids handed out by the InternTable. */
+    using intern_t = uint32_t;
+
+    /* Exception for when a string is interned on a thread on which no intern table is active. */
+    class NoInternTableException : public std::exception {
+    public:
+        /* Constructor for the NoInternTableException, which takes nothing. */
+        NoInternTableException() {}
+
+        /* Implementation for std::exception's what() function, so that it's compatible with C++'s uncaught-exception handling. */
+        virtual const char* what() const noexcept { return "Identifiers and property names can only be constructed while an InternTable::Scope is active."; }
+
+    };
+
+
+
+    /* The InternTable class stores each distinct string of a compilation once, and hands out a stable id for it. */
+    class InternTable {
+    private:
+        /* The interned strings, indexed by their id. A deque is used so the strings never move once added. */
+        std::deque<std::string> strings;
+        /* Maps each interned string (viewing into the strings list) to its id. */
+        std::unordered_map<std::string_view, intern_t> ids;
+
+        /* The intern table used by nodes constructed on this thread, if any. */
+        static thread_local InternTable* active;
+
+    public:
+        /* Default constructor for the InternTable class. */
+        InternTable() = default;
+        /* The copy constructor for the InternTable class is deleted, as nodes refer to the strings of a specific table. */
+        InternTable(const InternTable& other) = delete;
+
+        /* Returns the id of the given string, adding it to the table if it isn't interned yet. */
+        intern_t intern(const std::string_view& str);
+        /* Returns the string with the given id. The reference stays valid for as long as the table lives. */
+        inline const std::string& str(intern_t id) const { return this->strings[id]; }
+        /* Returns the number of distinct strings in the table. */
+        inline size_t size() const { return this->strings.size(); }
+
+        /* Returns the intern table used by nodes constructed on this thread. Throws a NoInternTableException if no table is active, since there is no table that each compilation could share without it growing forever. */
+        static InternTable& current();
+
+        /* The Scope class makes the given intern table the active one for as long as it lives, restoring the previous one once it goes out of scope. */
+        class Scope {
+        private:
+            /* The intern table that was active before this scope. */
+            InternTable* previous;
+
+        public:
+            /* Constructor for the Scope class, which takes the intern table to make active (or a nullptr to make none active). */
+            Scope(InternTable* table) : previous(InternTable::active) { InternTable::active = table; }
+            /* The copy constructor for the Scope class is deleted, as it would restore the previous table twice. */
+            Scope(const Scope& other) = delete;
+            /* Destructor for the Scope class, which restores the previously active intern table. */
+            ~Scope() { InternTable::active = this->previous; }
+
+        };
+
+    };
+}
+
+#endif
@@ -4,7 +4,7 @@
  * Created:
  *   26/11/2020, 11:26:44
  * Last edited:
- *   04/01/2021, 17:52:14
+ *   18/10/2026, 15:06:56
  * Auto updated?
  *   Yes
  *
@@ -28,13 +28,15 @@ namespace ArgumentParser {
     public:
         /* Constructor for the ADLLeaf, which takes the type of the derived file and a DebugInfo struct containing the information where this node came from. */
         ADLLeaf(NodeType type, const DebugInfo& debug);
+        /* Constructor for the ADLLeaf, which takes the type of the derived file and a DebugInfo struct containing the information where this node came from, which is moved into the node. */
+        ADLLeaf(NodeType type, DebugInfo&& debug);
         /* Virtual destructor for the ADLLeaf class, which is just the default one but virtual. */
         virtual ~ADLLeaf() = default;
         
-        /* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-        virtual void traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*));
-        /* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-        virtual void traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state);
+        /* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Always returns this node itself, as leaves have no children to replace. */
+        virtual ADLNode* traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*));
+        /* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Always returns this node itself, as leaves have no children to replace. */
+        virtual ADLNode* traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state);
 
     };
 };
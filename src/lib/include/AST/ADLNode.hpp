@@ -4,7 +4,7 @@
  * Created:
  *   18/11/2020, 20:37:00
  * Last edited:
- *   04/01/2021, 17:49:51
+ *   18/10/2026, 19:23:05
  * Auto updated?
  *   Yes
  *
@@ -20,6 +20,7 @@
 #include <string>
 #include <ostream>
 
+#include "ADLArena.hpp"
 #include "DebugInfo.hpp"
 #include "NodeType.hpp"
 #include "WarningTypes.hpp"
@@ -32,27 +33,38 @@ namespace ArgumentParser {
         const NodeType type;
         /* The debug information noting where this node originates from. */
         DebugInfo debug;
-        /* A list of warnings that are suppressed for this node. */
-        Exceptions::WarningType suppressed;
 
-        /* The parent node of this node. */
+        /* The parent node of this node. Only reliable for nodes that aren't shared between trees (see refs): a shared node keeps pointing to the parent it had in the tree it was cloned from, so traversals should track where they are on the way down instead of walking up. */
         ADLNode* parent;
+        /* The number of branches that hold this node as a child. Nodes with more than one are shared between (cloned) trees, and should only be changed by returning a replacement from a traversal, which copies the branches above it on write. */
+        size_t refs;
 
 
-        /* Constructor for the ADLNode, which takes the type of the node and the debug information of where this nodes originates. Note that it automatically assings all currently suppressed tokens in the static error handler as suppressed for this node. */
+        /* Constructor for the ADLNode, which takes the type of the node and the debug information of where this nodes originates. */
         ADLNode(NodeType type, const DebugInfo& debug);
+        /* Constructor for the ADLNode, which takes the type of the node and the debug information of where this nodes originates, which is moved into the node. */
+        ADLNode(NodeType type, DebugInfo&& debug);
+        /* Copy constructor for the ADLNode, which copies everything except the number of branches holding the node. */
+        ADLNode(const ADLNode& other);
         /* Virtual destructor for the ADLNode class, which doesn't do a lot yet. */
         virtual ~ADLNode() = default;
 
+        /* Allocates memory for a node in the currently active ADLArena, or on the heap if there is none. */
+        static void* operator new(size_t n);
+        /* Deallocates the memory of a node, which only does something if it was allocated on the heap; arena memory is released with the arena itself. */
+        static void operator delete(void* ptr);
+        /* Drops one of the branches holding the given node, deallocating the node once none are left. */
+        static void release(ADLNode* node);
+
         /* Traverses through the tree and calls the given traversal function for any node that matches any of the given node types. The trav_id is used for debugging purposes, to help identify which traversal went wrong. This particular overlead does not carry states between trav_func calls. */
         ADLNode* traverse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*));
         /* Traverses through the tree and calls the given traversal function for any node that matches any of the given node types. The trav_id is used for debugging purposes, to help identify which traversal went wrong. This particular overlead carries a state between trav_func calls, which is initialized with the given value (as std::any). */
         ADLNode* traverse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state);
 
-        /* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-        virtual void traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*)) = 0;
-        /* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. */
-        virtual void traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state) = 0;
+        /* Function that will recurse the (stateless) traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Returns the node to use in place of this one, which is a copy if this node is shared and one of its children was replaced. */
+        virtual ADLNode* traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*)) = 0;
+        /* Function that will recurse the traversal one layer deeper if the trav function needn't be called for this one. Note that this function may replace (and therefore deallocate) older nodes if it proves needed. Returns the node to use in place of this one, which is a copy if this node is shared and one of its children was replaced. */
+        virtual ADLNode* traverse_recurse(const char* trav_id, NodeType node_types, ADLNode* (*trav_func)(const char*, ADLNode*, void*), void* state) = 0;
 
         /* Virtual function to let the Node (and its children, if any) print itself to the given oustream. Note that this will take multiple lines, and should reflect the structure as defined by the AST. */
         virtual std::ostream& print(std::ostream& os) const = 0;
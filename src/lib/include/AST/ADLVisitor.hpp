@@ -0,0 +1,87 @@
+/* ADLVISITOR.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 15:26:40
+ * Last edited:
+ *   18/10/2026, 17:58:42
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains a compile-time alternative to ADLNode::traverse(). Instead of
+ *   a function pointer and a void-pointer state, the visit() functions are
+ *   templated on a functor, which carries its own (typed) state and which
+ *   the compiler can inline. Recursion doesn't go through the virtual
+ *   traverse_recurse() either, but dispatches on the NodeType instead.
+**/
+
+#ifndef ADL_VISITOR_HPP
+#define ADL_VISITOR_HPP
+
+#include "ADLNode.hpp"
+#include "ADLBranch.hpp"
+#include "ASTExceptions.hpp"
+#include "NodeType.hpp"
+
+namespace ArgumentParser {
+    template <class VISITOR>
+    ADLNode* visit_children(const char* trav_id, ADLNode* node, NodeType node_types, VISITOR& visitor);
+
+    /* Visits the given node and its children, calling the given visitor for any node that matches any of the given node types. The visitor is called as 'ADLNode* visitor(const char* trav_id, ADLNode* node)', and may return another node to replace the given one. Like with ADLNode::traverse(), the visitor itself is responsible for recursing deeper (using visit_children()) for the nodes it is called on. Returns the (possibly replaced) node. */
+    template <class VISITOR>
+    inline ADLNode* visit(const char* trav_id, ADLNode* node, NodeType node_types, VISITOR& visitor) {
+        // Only call the visitor on this node if we're of the target type
+        if (node->type & node_types) { return visitor(trav_id, node); }
+
+        // Otherwise, default to the normal recursion
+        return visit_children(trav_id, node, node_types, visitor);
+    }
+
+    /* Visits the children of the given node (if it has any) with the given visitor, replacing those for which it returns another node. Like ADLBranch::traverse_recurse(), a node shared with another tree is copied before its children are replaced; returns the copy in that case, or the given node otherwise. */
+    template <class VISITOR>
+    ADLNode* visit_children(const char* trav_id, ADLNode* node, NodeType node_types, VISITOR& visitor) {
+        switch (node->type) {
+            case NodeType::root:
+            case NodeType::meta:
+            case NodeType::type_def:
+            case NodeType::positional:
+            case NodeType::option:
+            case NodeType::types:
+            case NodeType::configs:
+            case NodeType::config:
+            case NodeType::values:
+            case NodeType::reference:
+                {
+                    ADLBranch* branch = (ADLBranch*) node;
+                    ADLBranch::SharedScope scope(branch);
+
+                    // Loop through all children, possibly replacing them
+                    ADLBranch* result = branch;
+                    for (size_t i = 0; i < branch->children.size(); i++) {
+                        ADLNode* child = branch->children[i];
+                        ADLNode* new_node = visit(trav_id, child, node_types, visitor);
+
+                        // Replace it if it changed, making sure the new node is whitelisted
+                        if (new_node != child) {
+                            if (!(new_node->type & branch->whitelist)) {
+                                throw Exceptions::IllegalChildException("visit_children()", trav_id, branch->whitelist, new_node->type);
+                            }
+
+                            // If another tree can see this branch, replace the child in a copy of it instead
+                            if (ADLBranch::in_shared && result == branch) { result = (ADLBranch*) branch->copy(); }
+                            result->replace_child(i, new_node);
+                        }
+                    }
+
+                    return result;
+                }
+
+            default:
+                // Leaves have nothing to recurse into
+                return node;
+        }
+    }
+}
+
+#endif
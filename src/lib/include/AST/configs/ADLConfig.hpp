@@ -4,7 +4,7 @@
  * Created:
  *   27/11/2020, 16:24:48
  * Last edited:
- *   08/12/2020, 20:46:24
+ *   18/10/2026, 14:50:23
  * Auto updated?
  *   Yes
  *
@@ -18,7 +18,9 @@
 #define ADL_CONFIG_HPP
 
 #include <string>
+#include <string_view>
 
+#include "ADLInternTable.hpp"
 #include "ADLBranch.hpp"
 #include "ADLValues.hpp"
 #include "NodeType.hpp"
@@ -27,11 +29,13 @@ namespace ArgumentParser {
     /* The ADLConfig class wraps a single configuration key / value(s) pair. */
     class ADLConfig: public ADLBranch {
     public:
-        /* The keyword stored in this ADLConfig, determining what parameter is given the values it stores. */
-        std::string param;
+        /* The id of the keyword in the intern table. */
+        intern_t param_id;
+        /* The keyword stored in this ADLConfig, determining what parameter is given the values it stores. Lives in the intern table. */
+        const std::string& param;
 
-        /* Constructor for the ADLConfig class, which takes debug information on the node's origin, the name of the parameter configured and a list of values as ADLValues. */
-        ADLConfig(const DebugInfo& debug, const std::string& param, ADLValues* values);
+        /* Constructor for the ADLConfig class, which takes debug information on the node's origin, the name of the parameter configured (which is interned in the current intern table) and a list of values as ADLValues. */
+        ADLConfig(const DebugInfo& debug, const std::string_view& param, ADLValues* values);
 
         /* Prints the configuration as the parameter name, all values and then a semicolon to the given output stream. */
         virtual std::ostream& print(std::ostream& os) const;
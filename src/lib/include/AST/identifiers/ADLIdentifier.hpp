@@ -4,7 +4,7 @@
  * Created:
  *   10/12/2020, 16:33:50
  * Last edited:
- *   11/02/2021, 16:45:07
+ *   18/10/2026, 14:50:23
  * Auto updated?
  *   Yes
  *
@@ -20,8 +20,10 @@
 #define ADL_IDENTIFIER_HPP
 
 #include <string>
+#include <string_view>
 #include <ostream>
 
+#include "ADLInternTable.hpp"
 #include "ADLLeaf.hpp"
 #include "NodeType.hpp"
 
@@ -39,13 +41,17 @@ namespace ArgumentParser {
     /* The ADLIdentifier class is used to wrap the identifiers used in the ADL. */
     class ADLIdentifier: public ADLLeaf {
     public:
-        /* The string value of the identifier. */
-        std::string identifier;  
+        /* The id of the identifier's value in the intern table, which can be compared to that of other identifiers from the same compilation. */
+        intern_t id;
+        /* The string value of the identifier, which lives in the intern table. */
+        const std::string& identifier;
         /* The type of the identifier, as IdentifierType. */
         IdentifierType type;
 
-        /* Constructor for the ADLIdentifier class, which takes debugging information, the identifier value we wrap and the type of said identifier. */
-        ADLIdentifier(const DebugInfo& debug, const std::string& identifier, IdentifierType identifier_type);
+        /* Constructor for the ADLIdentifier class, which takes debugging information, the identifier value we wrap (which is interned in the current intern table) and the type of said identifier. */
+        ADLIdentifier(const DebugInfo& debug, const std::string_view& identifier, IdentifierType identifier_type);
+        /* Constructor for the ADLIdentifier class, which takes debugging information, the identifier value we wrap (which is interned in the current intern table) and the type of said identifier. The debugging information is moved into the node. */
+        ADLIdentifier(DebugInfo&& debug, const std::string_view& identifier, IdentifierType identifier_type);
 
         /* Prints the identifier's value to the given output stream, possible wrapped in <> or preceded by - or --. */
         virtual std::ostream& print(std::ostream& os) const;
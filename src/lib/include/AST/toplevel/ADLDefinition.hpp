@@ -4,7 +4,7 @@
  * Created:
  *   04/01/2021, 18:09:03
  * Last edited:
- *   11/02/2021, 17:53:59
+ *   18/10/2026, 19:26:15
  * Auto updated?
  *   Yes
  *
@@ -26,6 +26,10 @@
 namespace ArgumentParser {
     /* The ADLDefinition class forms a baseclass for all toplevel definitions in the ArgumentParser. */
     class ADLDefinition: public ADLBranch {
+    protected:
+        /* Points the identifier, label or configs pointer that pointed to the given old child to the given new one instead, or to nothing if the new child isn't of the same type. */
+        virtual void rebind(ADLNode* old_node, ADLNode* new_node);
+
     public:
         /* Pointer that points to the identifier of this Definition. */
         ADLIdentifier* identifier;
@@ -55,7 +59,7 @@ namespace ArgumentParser {
         ADLDefinition(NodeType type, const DebugInfo& debug, size_t max_children, ADLIdentifier* shortlabel, ADLIdentifier* longlabel, ADLConfigs* configs = nullptr);
         /* Constructor for the ADLDefinition class, which takes the node type, the debug information for this node, the maximum number of children, a whitelist of NodeTypes to accept as children, an optional shortlabel for the node, and optional longlabel and optionally a list of configs. Derived Option classes use the longlabel if both are given. */
         ADLDefinition(NodeType type, const DebugInfo& debug, size_t max_children, NodeType whitelist, ADLIdentifier* shortlabel, ADLIdentifier* longlabel, ADLConfigs* configs = nullptr);
-        /* Copy constructor for the ADLDefinition class. */
+        /* Copy constructor for the ADLDefinition class, which shares the children with the other definition but copies its symbol table, so either can be changed without affecting the other. Like the references into the definition, its entries keep pointing to the nodes of the other one. */
         ADLDefinition(const ADLDefinition& other);
         /* Virtual destructor for the ADLDefinition class. */
         virtual ~ADLDefinition() = default;
@@ -66,12 +70,12 @@ namespace ArgumentParser {
         /* Lets derived classes have a go at trying to store the given value/node for the given property key. Returns 'true' if it was successfull, or 'false' if no such property is relevant for the derived class. */
         virtual bool set_property(const std::string& key, const std::string& value) = 0;
 
-        /* Checks whether this node matches with the given identifier. */
+        /* Checks whether this node matches with the given identifier. Both should be interned in the same table. */
         inline bool has_identifier(ADLIdentifier* identifier) const {
             return
-                (this->identifier != nullptr && this->identifier->identifier == identifier->identifier) ||
-                (this->shortlabel != nullptr && this->shortlabel->identifier == identifier->identifier) ||
-                (this->longlabel != nullptr && this->longlabel->identifier == identifier->identifier)
+                (this->identifier != nullptr && this->identifier->id == identifier->id) ||
+                (this->shortlabel != nullptr && this->shortlabel->id == identifier->id) ||
+                (this->longlabel != nullptr && this->longlabel->id == identifier->id)
             ;
         }
 
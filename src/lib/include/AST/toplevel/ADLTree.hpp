@@ -4,7 +4,7 @@
  * Created:
  *   18/11/2020, 20:36:22
  * Last edited:
- *   11/02/2021, 17:59:44
+ *   18/10/2026, 19:43:52
  * Auto updated?
  *   Yes
  *
@@ -15,9 +15,14 @@
 #ifndef ADL_TREE_HPP
 #define ADL_TREE_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "SourceManager.hpp"
+#include "ADLArena.hpp"
+#include "ADLInternTable.hpp"
+#include "SuppressionList.hpp"
 #include "ADLDefinition.hpp"
 #include "NodeType.hpp"
 
@@ -25,16 +30,35 @@ namespace ArgumentParser {
     /* Class for the topmost node in the ADL AST. */
     class ADLTree : public ADLDefinition {
     public:
+        /* The arena in which the nodes of this tree were allocated, if any. Kept alive for as long as the tree is, and shared with copies of the tree that still use it. */
+        std::shared_ptr<ADLArena> arena;
+        /* The table in which the identifiers of this tree are interned, if any. Kept alive for as long as the tree is, since its nodes refer to the strings in it. */
+        std::shared_ptr<InternTable> interns;
+        /* The spans over which the @suppress modifiers in this tree suppress warnings, if any. Used to decide whether warnings about its nodes are shown. */
+        std::shared_ptr<Exceptions::SuppressionList> suppressions;
+        /* The ids of the files this tree was parsed from, which the tree retains in the source manager (so their contents can still be looked at, e.g., when re-parsing) until it's destroyed. */
+        std::vector<file_t> sources;
+
+
         /* Constructor for the ADLTree class, which takes the filename of the root file and optionally takes a toplevel node. */
         ADLTree(const std::string& root_file, ADLNode* toplevel = nullptr);
-        
+        /* Copy constructor for the ADLTree class, which shares the other's nodes and retains its files once more. */
+        ADLTree(const ADLTree& other);
+        /* Destructor for the ADLTree class, which releases all nodes before the arena they may live in is released, and then the files the tree was parsed from. */
+        virtual ~ADLTree();
+
+        /* Allocates memory for the tree itself, which always lives on the heap since it owns the arena its children may live in. */
+        static void* operator new(size_t n);
+        /* Deallocates the memory of the tree itself. */
+        static void operator delete(void* ptr);
+
         /* Lets the Tree-node have a go at trying to store the given value/node for the given property key. Returns 'true' if it was successfull, or 'false' if no such property is relevant for this class. */
         virtual bool set_property(const std::string& key, const std::string& value);
 
         /* Prints all nodes in this file, reflecting the AST structure. */
         virtual std::ostream& print(std::ostream& os) const;
 
-        /* Allows the ADLTree to be copied polymorphically. */
+        /* Allows the ADLTree to be copied polymorphically. This is cheap, as the copy shares all its nodes with this tree (and keeps its arena and interned strings alive); only nodes replaced in a traversal over either tree are copied. Note that the symbol tables are copied as-is, so the tree should be analysed before it is copied. */
         virtual ADLTree* copy() const;
 
     };
@@ -4,7 +4,7 @@
  * Created:
  *   30/11/2020, 17:49:26
  * Last edited:
- *   11/02/2021, 17:06:50
+ *   18/10/2026, 17:58:42
  * Auto updated?
  *   Yes
  *
@@ -27,6 +27,10 @@
 namespace ArgumentParser {
     /* The ADLReference class is used to represent a reference to another property. */
     class ADLReference: public ADLBranch {
+    protected:
+        /* Points the definition or property pointer that pointed to the given old child to the given new one instead. */
+        virtual void rebind(ADLNode* old_node, ADLNode* new_node);
+
     public:
         /* The ID of the definition (either a type ID, positional ID or Option short/longlabel) we reference. */
         ADLIdentifier* definition;
@@ -4,7 +4,7 @@
  * Created:
  *   25/11/2020, 18:11:33
  * Last edited:
- *   08/12/2020, 20:52:23
+ *   18/10/2026, 18:57:55
  * Auto updated?
  *   Yes
  *
@@ -0,0 +1,55 @@
+/* DIAGNOSTIC SINK.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 17:09:21
+ * Last edited:
+ *   18/10/2026, 17:09:21
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the DiagnosticSink class, which collects the diagnostics of
+ *   the tasks that make up one phase of a compilation (e.g., one file or
+ *   definition each) while they run on different threads. Each task logs
+ *   to a handler of its own, so collecting needs no locks at all, and
+ *   once the phase is done they are merged in task order and written in
+ *   source order. The output is thus the same no matter how the tasks
+ *   were scheduled, or whether they ran on threads at all.
+**/
+
+#ifndef DIAGNOSTIC_SINK_HPP
+#define DIAGNOSTIC_SINK_HPP
+
+#include <vector>
+
+#include "ADLExceptions.hpp"
+
+namespace ArgumentParser::Exceptions {
+    /* The DiagnosticSink class gives each task of a phase a handler of its own, and merges them into a target handler once the phase is done. */
+    class DiagnosticSink {
+    private:
+        /* The handler that the diagnostics of each phase end up in. */
+        ExceptionHandler& target;
+        /* The handler of each task in the current phase. Each is only touched by the thread running its task. */
+        std::vector<ExceptionHandler> tasks;
+
+    public:
+        /* Constructor for the DiagnosticSink class, which takes the handler that the diagnostics of each phase end up in. */
+        DiagnosticSink(ExceptionHandler& target);
+        /* The copy constructor for the DiagnosticSink class is deleted, as tasks may still be logging to its handlers. */
+        DiagnosticSink(const DiagnosticSink& other) = delete;
+
+        /* Starts a phase of the given number of tasks, giving each an empty handler with the same settings as the target. Must be called before any of the tasks starts. */
+        void begin(size_t n_tasks);
+        /* Returns the handler of the given task, which should be made active on whichever thread runs it. Tasks may run concurrently, as long as each task runs on one thread at a time. */
+        inline ExceptionHandler& operator[](size_t task) { return this->tasks[task]; }
+        /* Returns the number of tasks in the current phase. */
+        inline size_t size() const { return this->tasks.size(); }
+        /* Ends the phase by merging the handlers of its tasks into the target in task order, after all tasks have finished. If the target prints on add, the whole phase is written at once, sorted by source location. Returns the target. */
+        ExceptionHandler& end();
+
+    };
+}
+
+#endif
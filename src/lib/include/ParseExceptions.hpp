@@ -4,7 +4,7 @@
  * Created:
  *   12/9/2020, 5:58:13 PM
  * Last edited:
- *   2/9/2021, 3:38:05 PM
+ *   18/10/2026, 16:46:57
  * Auto updated?
  *   Yes
  *
@@ -22,9 +22,9 @@ namespace ArgumentParser::Exceptions {
     /* Baseclass exception for all Parser-related errors. */
     class ParseError: public ADLCompileError {
     public:
-        /* Constructor for the ParseError class, which takes a DebugInfo struct linking this warning to a location in the source file and optionally a message. */
-        ParseError(const DebugInfo& debug, const std::string& message = "") :
-            ADLCompileError(debug, message)
+        /* Constructor for the ParseError class, which takes a DebugInfo struct linking this warning to a location in the source file, optionally the template of a message and the arguments to fill in it. */
+        ParseError(const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ADLCompileError(debug, format, args)
         {}
 
     };
@@ -71,7 +71,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the the MissingLSquareError class, which takes a debug info struct for where we expected the lcurly to be. */
         MissingLSquareError(const DebugInfo& debug) :
-            ParseError(DebugInfo(debug.filenames, debug.line2, debug.col2 + 1, debug.raw_line), "Expected a left square bracket to start optional brackets.")
+            ParseError(DebugInfo(debug.filenames, debug.line2, debug.col2 + 1), "Expected a left square bracket to start optional brackets.")
         {}
 
         /* Copies the MissingLSquareError polymorphically. */
@@ -95,7 +95,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the the MissingSemicolonError class, which takes a debug info struct for where we expected the semicolon to be. */
         MissingSemicolonError(const DebugInfo& debug) :
-            ParseError(DebugInfo(debug.filenames, debug.line2, debug.col2 + 1, debug.raw_line), "Expected a semicolon to end a property definition.")
+            ParseError(DebugInfo(debug.filenames, debug.line2, debug.col2 + 1), "Expected a semicolon to end a property definition.")
         {}
 
         /* Copies the MissingSemicolonError polymorphically. */
@@ -281,7 +281,7 @@ namespace ArgumentParser::Exceptions {
 
         /* Constructor for the the UnknownWarningError class, which takes a debug info struct to the config parameter and the raw name that was unknown. */
         UnknownWarningError(const DebugInfo& debug, const std::string& given_warning_name) :
-            ParseError(debug, "Unknown warning '" + given_warning_name + "'."),
+            ParseError(debug, "Unknown warning '{0}'.", { given_warning_name }),
             given(given_warning_name)
         {}
 
@@ -295,7 +295,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the CustomError class, which takes debug information and the custom message the user wants to display. */
         CustomError(const DebugInfo& debug, const std::string& message) :
-            ParseError(debug, message)
+            ParseError(debug, "{0}", { message })
         {}
 
         /* Polymorphically copies the CustomError class. */
@@ -308,9 +308,9 @@ namespace ArgumentParser::Exceptions {
     /* Baseclass exception for all Parser-related warnings. */
     class ParseWarning : public ADLCompileWarning {
     public:
-        /* Constructor for the ParseWarning class, which takes a DebugInfo struct linking this warning to a location in the source file and optionally a message. */
-        ParseWarning(WarningType type, const DebugInfo& debug, const std::string& message = "") :
-            ADLCompileWarning(type, debug, message)
+        /* Constructor for the ParseWarning class, which takes a DebugInfo struct linking this warning to a location in the source file, optionally the template of a message and the arguments to fill in it. */
+        ParseWarning(WarningType type, const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ADLCompileWarning(type, debug, format, args)
         {}
 
     };
@@ -318,9 +318,12 @@ namespace ArgumentParser::Exceptions {
     /* Warning for when a given statement is empty. */
     class EmptyStatementWarning: public ParseWarning {
     public:
+        /* The type of this warning. */
+        static constexpr WarningType warning_type = WarningType::empty_statement;
+
         /* Constructor for the the EmptyStatementWarning class, which takes a debug info struct to the config parameter. */
         EmptyStatementWarning(const DebugInfo& debug) :
-            ParseWarning(WarningType::empty_statement, debug, "Empty property statement encountered.")
+            ParseWarning(warning_type, debug, "Empty property statement encountered.")
         {}
 
         /* Copies the EmptyStatementWarning polymorphically. */
@@ -330,9 +333,12 @@ namespace ArgumentParser::Exceptions {
     /* Warning for when a semicolon follows anything unexpected. */
     class StraySemicolonWarning: public ParseWarning  {
     public:
+        /* The type of this warning. */
+        static constexpr WarningType warning_type = WarningType::stray_semicolon;
+
         /* Constructor for the the StraySemicolonWarning class, which takes a debug info struct to the config parameter. */
         StraySemicolonWarning(const DebugInfo& debug) :
-            ParseWarning(WarningType::stray_semicolon, debug, "Unnecessary semicolon encountered.")
+            ParseWarning(warning_type, debug, "Unnecessary semicolon encountered.")
         {}
 
         /* Copies the StraySemicolonWarning polymorphically. */
@@ -342,9 +348,12 @@ namespace ArgumentParser::Exceptions {
     /* Exception for when a suppress-modifier is at a non-sensible location. */
     class StraySuppressWarning: public ParseWarning {
     public:
+        /* The type of this warning. */
+        static constexpr WarningType warning_type = WarningType::stray_suppress;
+
         /* Constructor for the StraySuppressWarning class, which takes debugging information where the modifier illegally occurred. */
         StraySuppressWarning(const DebugInfo& debug) :
-            ParseWarning(WarningType::stray_suppress, debug, "Unexpected modifier encountered; doesn't do anything.")
+            ParseWarning(warning_type, debug, "Unexpected modifier encountered; doesn't do anything.")
         {}
 
         /* Copies the StraySuppressWarning polymorphically. */
@@ -355,9 +364,12 @@ namespace ArgumentParser::Exceptions {
     /* Custom warning that a user can throw with @warning. */
     class CustomWarning: public ParseWarning {
     public:
+        /* The type of this warning. */
+        static constexpr WarningType warning_type = WarningType::custom;
+
         /* Constructor for the CustomWarning class, which takes debug information and the custom message the user wants to display. */
         CustomWarning(const DebugInfo& debug, const std::string& message) :
-            ParseWarning(WarningType::custom, debug, message)
+            ParseWarning(warning_type, debug, "{0}", { message })
         {}
 
         /* Polymorphically copies the CustomWarning class. */
@@ -370,9 +382,9 @@ namespace ArgumentParser::Exceptions {
     /* Baseclass exception for all Parser-related notes, accompanying any of the above errors or warnings. */
     class ParseNote: public ADLNote {
     public:
-        /* Constructor for the ParseNote class, which takes a DebugInfo struct linking this note to a location in the source file and optionally a message. */
-        ParseNote(const DebugInfo& debug, const std::string& message = "") :
-            ADLNote(debug, message)
+        /* Constructor for the ParseNote class, which takes a DebugInfo struct linking this note to a location in the source file, optionally the template of a message and the arguments to fill in it. */
+        ParseNote(const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ADLNote(debug, format, args)
         {}
 
     };
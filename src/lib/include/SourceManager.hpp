@@ -0,0 +1,136 @@
+/* SOURCE MANAGER.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 16:21:40
+ * Last edited:
+ *   18/10/2026, 20:16:26
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the SourceManager class, which keeps the contents of every
+ *   file that is tokenized together with a table of where each of its
+ *   lines starts. Diagnostics only carry positions, and the snippet of
+ *   source they show is cut from the file once it's rendered. The
+ *   contents are freed once the trees and handlers that retained them
+ *   are gone.
+**/
+
+#ifndef SOURCE_MANAGER_HPP
+#define SOURCE_MANAGER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ArgumentParser {
+    /* The LineSnippet struct is used to carry a piece of a line, noted which line and from where to where. */
+    struct LineSnippet {
+        /* The column number of the first character in the snippet. */
+        size_t col1;
+        /* The column number of the last character in the snippet. */
+        size_t col2;
+        /* The line snippet itself, without its newline. */
+        std::string snippet;
+
+        /* Default constructor for the LineSnippet, which initializes it as an empty snippet. */
+        LineSnippet() : col1(0), col2(0) {}
+        /* Constructor for the LineSnippet which takes the column numbers and the string itself. */
+        LineSnippet(size_t col1, size_t col2, const std::string& snippet) :
+            col1(col1), col2(col2), snippet(snippet)
+        {}
+    };
+
+
+
+    /* The type of the ids handed out by the SourceManager. */
+    using file_t = uint32_t;
+    /* The type of the ids of include paths handed out by the SourceManager. */
+    using trail_t = uint32_t;
+
+    /* The SourceManager class stores the contents of each source file once, and maps between line & column numbers and byte offsets in them. A file's contents are freed as soon as the last one to retain it (e.g., the tree parsed from it or a handler with diagnostics in it) releases it; its id and path stay valid. All its functions may be called from multiple threads at once. */
+    class SourceManager {
+    private:
+        /* The contents of a single source file. */
+        struct SourceFile {
+            /* The path of the file. */
+            std::string path;
+            /* The bytes in the file. */
+            std::string bytes;
+            /* The offset at which each line starts, where the first line starts at 0. */
+            std::vector<size_t> lines;
+            /* The snippets that have been cut from the file so far, by their line and window. */
+            std::unordered_map<uint64_t, LineSnippet> snippets;
+            /* The number of times the file has been retained and not yet released. */
+            size_t users;
+        };
+
+        /* The files, indexed by their id. A deque is used so the files never move once added. */
+        std::deque<SourceFile> files;
+        /* Maps each path to the id of its file. */
+        std::unordered_map<std::string, file_t> ids;
+        /* The include paths that diagnostics point to, indexed by their id. A deque is used so they never move once added. */
+        std::deque<std::vector<std::string>> trails;
+        /* Maps each include path to its id. */
+        std::map<std::vector<std::string>, trail_t> trail_ids;
+        /* Guards the files, since different compilations may share them. */
+        mutable std::mutex lock;
+
+    public:
+        /* Value returned by find() for files that aren't known. */
+        static constexpr file_t none = UINT32_MAX;
+        /* The maximum number of columns in a snippet. Longer lines are shown through a window around the position they're shown for. */
+        static constexpr size_t snippet_width = 100;
+
+
+        /* Default constructor for the SourceManager class. */
+        SourceManager() = default;
+        /* The copy constructor for the SourceManager class is deleted, as diagnostics refer to the files of a specific manager. */
+        SourceManager(const SourceManager& other) = delete;
+
+        /* Stores the given bytes as the contents of the file at the given path, replacing any earlier contents (and the snippets cut from them) if they differ. If retain is true, the file is retained in the same go, so no other thread can free it in between. Returns the id of the file. */
+        file_t add(const std::string& path, std::string&& bytes, bool retain = false);
+        /* Stores the contents of the given stream as those of the file at the given path, reading it from the start and then restoring its position. If retain is true, the file is retained in the same go. Returns the id of the file, or SourceManager::none if the stream can't be rewound. */
+        file_t load(const std::string& path, std::istream& stream, bool retain = false);
+        /* Returns the id of the file at the given path, or SourceManager::none if it isn't known. */
+        file_t find(const std::string& path) const;
+        /* Forgets all files and include paths, e.g., in between unrelated compilations in one process. Should only be called once no handler holds the diagnostics of earlier compilations anymore, since they refer to both. */
+        void clear();
+
+        /* Returns the id of the given include path (a file preceded by the files that included it), adding it if it's new. Include paths are never forgotten until clear(), since there are only as many as there are include chains. */
+        trail_t trail(const std::vector<std::string>& filenames);
+        /* Returns the include path with the given id. */
+        const std::vector<std::string>& filenames(trail_t trail) const;
+
+        /* Keeps the contents of the given file until it's released as often as it's been retained. Should only be called for files that are already retained (or that were just added), since the contents of files that have been freed don't come back. */
+        void retain(file_t file);
+        /* Releases the given file once, freeing its contents (and the snippets cut from them) if nobody retains it anymore. Files that were never retained are kept until clear(). */
+        void release(file_t file);
+
+        /* Returns the number of bytes in the given file, which is 0 once its contents have been freed. */
+        size_t length(file_t file) const;
+        /* Returns the byte offset of the given line & column number in the given file. Positions past the end of a line or the file are clamped to it, and all positions are at 0 in files whose contents have been freed. */
+        size_t offset(file_t file, size_t line, size_t col) const;
+        /* Returns one past the byte offset of the given line & column number in the file that the given include path ends in, or 0 if that file isn't known or its contents have been freed. Positions are clamped like offset() does. */
+        size_t trail_offset(trail_t trail, size_t line, size_t col) const;
+        /* Returns the line & column number of the given byte offset in the given file through the given references, which are both 0 if the file's contents have been freed. */
+        void position(file_t file, size_t offset, size_t& line, size_t& col) const;
+        /* Copies at most snippet_width columns of the given line in the given file, chosen such that the given column is in them, to the given snippet. The window is cut only once for all columns that share it. Returns false if there is no such line. */
+        bool snippet(file_t file, size_t line, size_t col, LineSnippet& result);
+
+    };
+
+
+
+    /* Process-wide source manager, which holds every file that has been tokenized for as long as something still needs it. */
+    inline SourceManager source_manager;
+
+}
+
+#endif
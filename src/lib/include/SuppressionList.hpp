@@ -0,0 +1,136 @@
+/* SUPPRESSION LIST.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 16:58:12
+ * Last edited:
+ *   18/10/2026, 19:56:04
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Contains the SuppressionList class, which records which warnings are
+ *   suppressed where in the source files of a compilation. Each @suppress
+ *   modifier becomes a span of source over which a set of warning types
+ *   is suppressed, so whether a warning is suppressed only depends on
+ *   where it points to, no matter when it is logged.
+**/
+
+#ifndef SUPPRESSION_LIST_HPP
+#define SUPPRESSION_LIST_HPP
+
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DebugInfo.hpp"
+#include "WarningTypes.hpp"
+
+namespace ArgumentParser::Exceptions {
+    /* Exception for when suppressions are recorded on a thread on which no suppression list is active. */
+    class NoSuppressionListException : public std::exception {
+    public:
+        /* Constructor for the NoSuppressionListException, which takes nothing. */
+        NoSuppressionListException() {}
+
+        /* Implementation for std::exception's what() function, so that it's compatible with C++'s uncaught-exception handling. */
+        virtual const char* what() const noexcept { return "Suppressions can only be recorded while a SuppressionList::Scope is active."; }
+
+    };
+
+
+
+    /* The scopes that a suppression can apply to. Spans in the same scope never overlap, while a config span always lies within a toplevel one. */
+    enum class SuppressionScope {
+        /* The suppression applies to the toplevel definition that follows it. */
+        toplevel = 0,
+        /* The suppression applies to the property that follows it. */
+        config = 1
+    };
+
+
+
+    /* The SuppressionList class stores, for each source file, the spans over which warnings are suppressed, sorted such that finding the spans around a position is a binary search. */
+    class SuppressionList {
+    private:
+        /* A span of source over which a set of warnings is suppressed. */
+        struct Span {
+            /* The line where the span starts. */
+            size_t line1;
+            /* The column where the span starts. */
+            size_t col1;
+            /* The line where the span ends, or SuppressionList::open if it hasn't been closed yet. */
+            size_t line2;
+            /* The column where the span ends. */
+            size_t col2;
+            /* The warning types suppressed in the span. */
+            WarningType types;
+        };
+        /* The spans of a single file, per scope and sorted by where they start. */
+        struct FileSpans {
+            /* The spans for each scope. */
+            std::vector<Span> scopes[2];
+        };
+
+        /* The spans of each file, by its path. */
+        std::unordered_map<std::string, FileSpans> files;
+        /* All warning types that are suppressed anywhere, so positions only have to be looked up for those. */
+        WarningType all_types;
+
+        /* The suppression list used by the parser and the handler on this thread, if any. */
+        static thread_local SuppressionList* active;
+
+        /* Returns whether the first span starts before the second one. */
+        static bool starts_before(const Span& s1, const Span& s2);
+
+    public:
+        /* Value for the end of spans that haven't been closed yet, which thus reach until the end of the file. */
+        static constexpr size_t open = SIZE_MAX;
+
+
+        /* Default constructor for the SuppressionList class. */
+        SuppressionList();
+
+        /* Suppresses the given warning types from the given position on, in the given scope. If the last span of that scope in the position's file is still open, the types are added to it instead. */
+        void suppress(SuppressionScope scope, const DebugInfo& start, WarningType types);
+        /* Closes the open span of the given scope in the file of the given position (if any) at the end of that position. */
+        void close(SuppressionScope scope, const DebugInfo& end);
+        /* Replaces all spans that start within the given range of the file it points to with the spans that the given list has for that file, moving the spans after the range such that it ends at the given position, and letting any span that ended at the end of the range end at the given position too. */
+        void splice(const DebugInfo& range, const SuppressionList& other, size_t line2, size_t col2);
+
+        /* Returns the warning types that are suppressed over the whole of the given position, i.e., by spans that contain it from its start to its end. */
+        WarningType suppressed(const DebugInfo& at) const;
+        /* Returns whether warnings of the given type are suppressed over the whole of the given position. */
+        inline bool suppressed(WarningType type, const DebugInfo& at) const { return (this->all_types & type) && (this->suppressed(at) & type); }
+        /* Returns all warning types that are suppressed anywhere. */
+        inline WarningType types() const { return this->all_types; }
+        /* Returns the number of spans in the list. */
+        size_t size() const;
+
+        /* Returns the suppression list used on this thread. Throws a NoSuppressionListException if no list is active, since there is no list that each compilation could share without it growing forever. */
+        static SuppressionList& current();
+        /* Returns whether the suppression list used on this thread suppresses warnings of the given type over the whole of the given position. If no list is active, nothing is suppressed. */
+        static inline bool active_suppresses(WarningType type, const DebugInfo& at) { return SuppressionList::active != nullptr && SuppressionList::active->suppressed(type, at); }
+
+        /* The Scope class makes the given suppression list the active one for as long as it lives, restoring the previous one once it goes out of scope. */
+        class Scope {
+        private:
+            /* The suppression list that was active before this scope. */
+            SuppressionList* previous;
+
+        public:
+            /* Constructor for the Scope class, which takes the suppression list to make active (or a nullptr to make none active). */
+            Scope(SuppressionList* list) : previous(SuppressionList::active) { SuppressionList::active = list; }
+            /* The copy constructor for the Scope class is deleted, as it would restore the previous list twice. */
+            Scope(const Scope& other) = delete;
+            /* Destructor for the Scope class, which restores the previously active suppression list. */
+            ~Scope() { SuppressionList::active = this->previous; }
+
+        };
+
+    };
+}
+
+#endif
@@ -4,7 +4,7 @@
  * Created:
  *   13/11/2020, 15:33:42
  * Last edited:
- *   13/12/2020, 15:08:16
+ *   18/10/2026, 18:57:55
  * Auto updated?
  *   Yes
  *
@@ -77,7 +77,7 @@ namespace ArgumentParser::Parser {
         /* Returns the debug information of this token. */
         inline const DebugInfo& debug() const { return this->_token->debug; }
         /* Returns the raw value stored in this token. */
-        inline std::string raw() const { return this->_token->raw; }
+        inline const std::string& raw() const { return this->_token->raw; }
         /* Returns the parsed value stored in this token. */
         template <class T> inline T value() const { return ((ValueToken<T>*) this->_token)->value; }
 
@@ -101,12 +101,16 @@ namespace ArgumentParser::Parser {
     /* Used for non-terminal symbols, which are linked to ADLNodes. */
     class NonTerminal : public Symbol {
     private:
-        /* Internal reference to a ADLNode. Note that this is heap-allocated, but not managed by this NonTerminal as we work bottom-up. */
+        /* Internal reference to a ADLNode. Since we work bottom-up, it is usually adopted by a parent node before this NonTerminal goes; if it isn't, the NonTerminal frees it. */
         ADLNode* _node;
 
     public:
         /* Constructor for the NonTerminal, which takes a reference to a node. */
         NonTerminal(ADLNode* node);
+        /* Copy constructor for the NonTerminal, which copies the node as well. */
+        NonTerminal(const NonTerminal& other);
+        /* Destructor for the NonTerminal, which frees the node unless a parent has adopted it or it was taken out (by setting node() to a nullptr). */
+        ~NonTerminal();
 
         /* Returns a reference to the internal token. */
         inline ADLNode*& node() { return this->_node; }
@@ -199,6 +203,8 @@ namespace ArgumentParser::Parser {
 
         /* Adds a new terminal on the stack, based on the given token. */
         void add_terminal(Token* token);
+        /* Adds an already constructed NonTerminal on the stack. */
+        void add_nonterminal(NonTerminal* symbol);
         /* Replaces the first N symbols (deallocating them) with the new NonTerminal. */
         void replace(size_t N, NonTerminal* symbol);
         /* Removes the N first symbols from the stack (deallocating them). */
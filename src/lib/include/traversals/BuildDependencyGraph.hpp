@@ -0,0 +1,107 @@
+/* BUILD DEPENDENCY GRAPH.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 15:02:14
+ * Last edited:
+ *   18/10/2026, 19:23:05
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Builds a graph of which definitions and properties depend on which
+ *   others, based on the links made by the check_references traversal. A
+ *   definition depends on its own properties and on the typedefs it uses,
+ *   while a property depends on the properties it references. The graph
+ *   can be walked in both directions, ordered topologically and checked
+ *   for cycles.
+**/
+
+#ifndef BUILD_DEPENDENCY_GRAPH_HPP
+#define BUILD_DEPENDENCY_GRAPH_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ADLTree.hpp"
+#include "NodeType.hpp"
+
+namespace ArgumentParser {
+    /* The identifier for this traversal. */
+    static constexpr const char* build_dependency_graph_id = "build_dependency_graph";
+    /* The node types to which this traversal applies. */
+    static constexpr NodeType build_dependency_graph_types = NodeType::meta | NodeType::positional | NodeType::option | NodeType::type_def | NodeType::config | NodeType::types | NodeType::reference;
+
+
+
+    /* The DependencyGraph class stores which definitions and properties depend on which others, with the edges stored in both directions so either can be walked in time linear to the degree of a node. */
+    class DependencyGraph {
+    private:
+        /* The definition or property node behind each vertex. */
+        std::vector<ADLNode*> nodes;
+        /* Maps each node to its vertex. */
+        std::unordered_map<const ADLNode*, size_t> indices;
+        /* For each vertex, the vertices it depends on. */
+        std::vector<std::vector<size_t>> dependencies;
+        /* For each vertex, the vertices that depend on it. */
+        std::vector<std::vector<size_t>> dependents;
+        /* For each property vertex, the vertex of the definition it belongs to; DependencyGraph::none for definitions. Kept here since the parent of a node shared with a cloned tree may be in the other tree. */
+        std::vector<size_t> owners;
+        /* The total number of edges in the graph. */
+        size_t n_edges;
+
+    public:
+        /* Value returned by index() for nodes that aren't in the graph. */
+        static constexpr size_t none = SIZE_MAX;
+
+
+        /* Default constructor for the DependencyGraph class. */
+        DependencyGraph();
+
+        /* Adds a vertex for the given definition or property node if it has none yet. If an owner is given, it's remembered as the vertex of the definition the property belongs to. Returns the vertex of the node either way. */
+        size_t add(ADLNode* node, size_t owner = DependencyGraph::none);
+        /* Marks that the first vertex depends on the second one. Edges that already exist are not added again. */
+        void depend(size_t vertex, size_t dependency);
+
+        /* Returns the vertex of the given node, or DependencyGraph::none if it isn't in the graph. */
+        size_t index(const ADLNode* node) const;
+        /* Returns the definition or property node behind the given vertex. */
+        inline ADLNode* operator[](size_t vertex) const { return this->nodes[vertex]; }
+        /* Returns the vertex of the definition the property behind the given vertex belongs to, or DependencyGraph::none if it's a definition itself. */
+        inline size_t owner(size_t vertex) const { return this->owners[vertex]; }
+        /* Returns the number of vertices in the graph. */
+        inline size_t size() const { return this->nodes.size(); }
+        /* Returns the number of edges in the graph. */
+        inline size_t edges() const { return this->n_edges; }
+
+        /* Returns the vertices the given vertex directly depends on. */
+        inline const std::vector<size_t>& get_dependencies(size_t vertex) const { return this->dependencies[vertex]; }
+        /* Returns the vertices that directly depend on the given vertex. */
+        inline const std::vector<size_t>& get_dependents(size_t vertex) const { return this->dependents[vertex]; }
+        /* Returns all vertices the given vertex depends on, directly or indirectly, in breadth-first order. */
+        std::vector<size_t> transitive_dependencies(size_t vertex) const;
+        /* Returns all vertices that depend on the given vertex, directly or indirectly, in breadth-first order. */
+        std::vector<size_t> transitive_dependents(size_t vertex) const;
+
+        /* Returns the vertices in an order where each comes after everything it depends on. Vertices that are part of a cycle, or that depend on one, are left out. */
+        std::vector<size_t> topological_order() const;
+        /* Returns each cycle in the graph as the (sorted) list of vertices that are part of it. Cycles that share a vertex are returned as one. */
+        std::vector<std::vector<size_t>> cycles() const;
+
+        /* Returns a readable name for the given vertex, like '<uint>' for a definition or '<uint>.pattern' for a property. */
+        std::string label(size_t vertex) const;
+        /* Writes the graph to the given output stream in the DOT-format, listing the vertices in topological order first. */
+        std::ostream& print(std::ostream& os) const;
+
+    };
+
+
+
+    /* The traversal function that builds the dependency graph of the given tree, logging an error for each cycle in it. The tree should have gone through the build_symbol_table and check_references traversals already. */
+    DependencyGraph traversal_build_dependency_graph(ADLTree* tree);
+}
+
+#endif
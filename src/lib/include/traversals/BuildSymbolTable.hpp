@@ -4,7 +4,7 @@
  * Created:
  *   01/01/2021, 16:05:02
  * Last edited:
- *   01/01/2021, 16:24:12
+ *   18/10/2026, 19:23:05
  * Auto updated?
  *   Yes
  *
@@ -18,6 +18,7 @@
 #define BUILD_SYMBOL_TABLE_HPP
 
 #include "ADLTree.hpp"
+#include "ADLConfig.hpp"
 #include "ADLSymbolTable.hpp"
 #include "NodeType.hpp"
 
@@ -27,8 +28,17 @@ namespace ArgumentParser {
     /* The node types to which this traversal applies. */
     static constexpr NodeType build_symbol_table_types = NodeType::meta | NodeType::positional | NodeType::option | NodeType::type_def | NodeType::config;
 
+    /* Adds the given definition to the given (main) symbol table, once for each identifier it answers to. */
+    void register_definition(ADLDefinition* definition, SymbolTable& symbol_table);
+    /* Adds the given property to the symbol table of the given definition, which is the one it belongs to. */
+    void register_property(ADLDefinition* definition, ADLConfig* config);
+    /* Merges the symbol tables of all meta definitions in the given (main) symbol table into that of the first one, removing the others from the main table. */
+    void merge_metas(SymbolTable& symbol_table);
+
     /* The traversal function for the first traversal, that builds a main symbol table (and those in definition nodes) from the parsed AST. */
     SymbolTable traversal_build_symbol_table(ADLTree* tree);
+    /* Runs the first traversal for a single definition only, adding its identifiers to the given (main) symbol table and building its own nested one. Note that meta definitions are not merged. */
+    void traversal_build_symbol_table(ADLDefinition* definition, SymbolTable& symbol_table);
 }
 
 #endif
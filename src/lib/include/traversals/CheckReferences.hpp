@@ -4,7 +4,7 @@
  * Created:
  *   11/02/2021, 15:57:33
  * Last edited:
- *   11/02/2021, 17:35:10
+ *   18/10/2026, 14:21:52
  * Auto updated?
  *   Yes
  *
@@ -17,6 +17,8 @@
 #define CHECK_REFERENCES_HPP
 
 #include "ADLTree.hpp"
+#include "ADLTypes.hpp"
+#include "ADLReference.hpp"
 #include "ADLSymbolTable.hpp"
 #include "NodeType.hpp"
 
@@ -26,8 +28,15 @@ namespace ArgumentParser {
     /* The node types to which this traversal applies. */
     static constexpr NodeType check_references_types = NodeType::types | NodeType::reference;
 
+    /* Links each of the given types to the typedef it names in the given (main) symbol table, logging an error for those that don't exist. */
+    void resolve_types(ADLTypes* types, SymbolTable& symbol_table);
+    /* Links the given reference to the property it names, using the given (main) symbol table to find the definition it lives in. */
+    void resolve_reference(ADLReference* reference, SymbolTable& symbol_table);
+
     /* The traversal function for the first traversal, that builds a main symbol table (and those in definition nodes) from the parsed AST. */
     void traversal_check_references(ADLTree* tree);
+    /* Runs the second traversal for the given subtree of the given tree only, linking its (type-)references against the tree's symbol table. */
+    void traversal_check_references(ADLTree* tree, ADLNode* subtree);
 }
 
 #endif
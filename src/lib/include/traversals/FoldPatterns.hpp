@@ -0,0 +1,39 @@
+/* FOLD PATTERNS.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 15:15:47
+ * Last edited:
+ *   18/10/2026, 19:28:35
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Folds the values of each .pattern property that concatenates strings,
+ *   regular expressions and references to other properties into a single
+ *   regular expression. Properties are evaluated in dependency order, so
+ *   the folded value of each property only has to be computed once.
+**/
+
+#ifndef FOLD_PATTERNS_HPP
+#define FOLD_PATTERNS_HPP
+
+#include <cstddef>
+
+#include "ADLTree.hpp"
+#include "NodeType.hpp"
+#include "BuildDependencyGraph.hpp"
+
+namespace ArgumentParser {
+    /* The identifier for this traversal. */
+    static constexpr const char* fold_patterns_id = "fold_patterns";
+    /* The node types to which this traversal applies. */
+    static constexpr NodeType fold_patterns_types = nt_toplevel | NodeType::values;
+    /* The longest regular expression a property is folded into. Properties that would become longer are left as they are, since a pattern that references another one several times grows exponentially along a chain of them. */
+    static constexpr size_t fold_patterns_max_length = 1 << 16;
+
+    /* Replaces the values of each .pattern property in the given tree that consists of strings, regular expressions and references to such properties with one regular expression, using the given dependency graph of the tree to evaluate them in order. Returns the number of properties that were folded. The tree should have gone through the build_symbol_table and check_references traversals already. */
+    size_t traversal_fold_patterns(ADLTree* tree, const DependencyGraph& dependencies);
+}
+
+#endif
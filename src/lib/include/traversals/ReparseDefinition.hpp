@@ -0,0 +1,30 @@
+/* REPARSE DEFINITION.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 13:44:02
+ * Last edited:
+ *   18/10/2026, 19:33:02
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Incrementally updates an already parsed & analysed ADLTree after its
+ *   root file has changed. Only the toplevel definition that contains the
+ *   change is parsed again, after which it is spliced into the tree and
+ *   its entries in the symbol tables are patched in-place.
+**/
+
+#ifndef REPARSE_DEFINITION_HPP
+#define REPARSE_DEFINITION_HPP
+
+#include <cstddef>
+
+#include "ADLTree.hpp"
+
+namespace ArgumentParser {
+    /* Re-parses the toplevel definition in the given tree's root file that contains the changed byte range [offset, offset + length), where the range is given in terms of the file's new contents. The tree should have gone through the build_symbol_table and check_references traversals already. Returns true if the tree was successfully patched, or false if the change can't be handled incrementally (e.g., it spans multiple definitions, touches a macro or a meta definition, or contains errors). In the latter case, the tree is left untouched and the file should be parsed from scratch. Note that the change should be the only one since the tree was (re-)parsed, since the rest of the file is found by how much the file grew or shrunk. */
+    bool reparse_definition(ADLTree* tree, size_t offset, size_t length);
+}
+
+#endif
@@ -0,0 +1,39 @@
+/* SEMANTIC ANALYSIS.hpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:17:09
+ * Last edited:
+ *   18/10/2026, 14:25:48
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Fuses the build_symbol_table and check_references traversals into a
+ *   single walk over the tree. Types and references are collected while
+ *   the symbol tables are built, and are linked in a linear pass over
+ *   that list once all definitions are known.
+**/
+
+#ifndef SEMANTIC_ANALYSIS_HPP
+#define SEMANTIC_ANALYSIS_HPP
+
+#include "ADLTree.hpp"
+#include "ADLFlatTree.hpp"
+#include "NodeType.hpp"
+#include "BuildSymbolTable.hpp"
+#include "CheckReferences.hpp"
+
+namespace ArgumentParser {
+    /* The identifier for this traversal. */
+    static constexpr const char* semantic_analysis_id = "semantic_analysis";
+    /* The node types to which this traversal applies. */
+    static constexpr NodeType semantic_analysis_types = build_symbol_table_types | check_references_types;
+
+    /* Builds the main symbol table (and those in definition nodes) of the given tree and links all (type-)references in it, with the same result as running traversal_build_symbol_table() and traversal_check_references() after each other but with only one walk over the tree. */
+    void traversal_semantic_analysis(ADLTree* tree);
+    /* Does the same as traversal_semantic_analysis(tree), except that it streams through the given flattened version of the tree instead of walking it. */
+    void traversal_semantic_analysis(ADLTree* tree, const ADLFlatTree& flat);
+}
+
+#endif
@@ -4,7 +4,7 @@
  * Created:
  *   10/12/2020, 13:08:33
  * Last edited:
- *   11/02/2021, 17:39:47
+ *   18/10/2026, 15:30:03
  * Auto updated?
  *   Yes
  *
@@ -25,9 +25,9 @@ namespace ArgumentParser::Exceptions {
     /* Baseclass exception for all Traversal errors, derived from the ParseError. */
     class TraversalError: public ParseError {
     public:
-        /* Constructor for the TraversalError class, which takes debug information and optionally a message. */
-        TraversalError(const DebugInfo& debug, const std::string& message = "") :
-            ParseError(debug, message)
+        /* Constructor for the TraversalError class, which takes debug information, optionally the template of a message and the arguments to fill in it. */
+        TraversalError(const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ParseError(debug, format, args)
         {}
     };
 
@@ -37,9 +37,9 @@ namespace ArgumentParser::Exceptions {
         /* The identifier which was defined twice or more. */
         const std::string identifier;
 
-        /* Constructor for the DuplicateSymbolError class, which takes debug information, the identifier in question which was given twice and optionally a message. */
-        DuplicateSymbolError(const DebugInfo& debug, const std::string& identifier, const std::string& message = "") :
-            TraversalError(debug, message),
+        /* Constructor for the DuplicateSymbolError class, which takes debug information, the identifier in question which was given twice, optionally the template of a message and the arguments to fill in it. */
+        DuplicateSymbolError(const DebugInfo& debug, const std::string& identifier, const char* format = "", const std::vector<std::string>& args = {}) :
+            TraversalError(debug, format, args),
             identifier(identifier)
         {}
     };
@@ -48,7 +48,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the DuplicateArgumentError class, which takes debugging information and the identifier that was defined twice. */
         DuplicateArgumentError(const DebugInfo& debug, const std::string& identifier) :
-            DuplicateSymbolError(debug, identifier, "Argument '" + identifier + "' is already declared.")
+            DuplicateSymbolError(debug, identifier, "Argument '{0}' is already declared.", { identifier })
         {}
 
         /* Allows the DuplicateArgumentError to be copied polymorphically. */
@@ -60,7 +60,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the DuplicateTypeError class, which takes debugging information and the identifier that was defined twice. */
         DuplicateTypeError(const DebugInfo& debug, const std::string& identifier) :
-            DuplicateSymbolError(debug, identifier, "Type '" + identifier + "' is already declared.")
+            DuplicateSymbolError(debug, identifier, "Type '{0}' is already declared.", { identifier })
         {}
 
         /* Allows the DuplicateTypeError to be copied polymorphically. */
@@ -72,7 +72,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the DuplicatePropertyError class, which takes debugging information and the identifier that was defined twice. */
         DuplicatePropertyError(const DebugInfo& debug, const std::string& identifier) :
-            DuplicateSymbolError(debug, identifier, "Property '" + identifier + "' is already declared for this meta, argument or type definition.")
+            DuplicateSymbolError(debug, identifier, "Property '{0}' is already declared for this meta, argument or type definition.", { identifier })
         {}
 
         /* Allows the DuplicatePropertyError to be copied polymorphically. */
@@ -86,9 +86,9 @@ namespace ArgumentParser::Exceptions {
         /* The identifier which was referenced but not defined. */
         const std::string identifier;
 
-        /* Constructor for the UnknownSymbolError class, which takes debug information, the identifier in question and optionally a message. */
-        UnknownSymbolError(const DebugInfo& debug, const std::string& identifier, const std::string& message = "") :
-            TraversalError(debug, message),
+        /* Constructor for the UnknownSymbolError class, which takes debug information, the identifier in question, optionally the template of a message and the arguments to fill in it. */
+        UnknownSymbolError(const DebugInfo& debug, const std::string& identifier, const char* format = "", const std::vector<std::string>& args = {}) :
+            TraversalError(debug, format, args),
             identifier(identifier)
         {}
         
@@ -110,7 +110,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the UnknownArgumentError class, which takes debugging information and the identifier that was referenced but not defined. */
         UnknownArgumentError(const DebugInfo& debug, const std::string& identifier) :
-            UnknownSymbolError(debug, identifier, "No argument '" + identifier + "' found; did you misspell it?")
+            UnknownSymbolError(debug, identifier, "No argument '{0}' found; did you misspell it?", { identifier })
         {}
 
         /* Allows the UnknownArgumentError to be copied polymorphically. */
@@ -122,7 +122,7 @@ namespace ArgumentParser::Exceptions {
     public:
         /* Constructor for the UnknownTypeError class, which takes debugging information and the identifier that was referenced but not defined. */
         UnknownTypeError(const DebugInfo& debug, const std::string& identifier) :
-            UnknownSymbolError(debug, identifier, "No type '" + identifier + "' found; did you misspell it?")
+            UnknownSymbolError(debug, identifier, "No type '{0}' found; did you misspell it?", { identifier })
         {}
 
         /* Allows the UnknownTypeError to be copied polymorphically. */
@@ -137,7 +137,7 @@ namespace ArgumentParser::Exceptions {
 
         /* Constructor for the UnknownPropertyError class, which takes debugging information and the identifier that was referenced but not defined. */
         UnknownPropertyError(const DebugInfo& debug, const std::string& definition, const std::string& identifier) :
-            UnknownSymbolError(debug, identifier, "Definition '" + definition + "' has no property '" + identifier + "'; did you misspell it?"),
+            UnknownSymbolError(debug, identifier, "Definition '{0}' has no property '{1}'; did you misspell it?", { definition, identifier }),
             definition(definition)
         {}
 
@@ -146,14 +146,31 @@ namespace ArgumentParser::Exceptions {
 
     };
 
+    /* Error for when a property (indirectly) references itself, so its value can never be determined. */
+    class CyclicReferenceError: public TraversalError {
+    public:
+        /* The chain of properties that reference each other, as a readable string. */
+        const std::string cycle;
+
+        /* Constructor for the CyclicReferenceError class, which takes debugging information of the first property in the cycle and the cycle itself as a readable string. */
+        CyclicReferenceError(const DebugInfo& debug, const std::string& cycle) :
+            TraversalError(debug, "Property depends on itself through {0}.", { cycle }),
+            cycle(cycle)
+        {}
+
+        /* Allows the CyclicReferenceError to be copied polymorphically. */
+        virtual CyclicReferenceError* copy() const { return new CyclicReferenceError(*this); }
+
+    };
+
 
 
     /* Baseclass exception for all Traversal warnings, derived from the ParseWarning. */
     class TraversalWarning: public ParseWarning {
     public:
-        /* Constructor for the TraversalWarning class, which takes the type of the warning, debug information and optionally a message. */
-        TraversalWarning(WarningType type, const DebugInfo& debug, const std::string& message = "") :
-            ParseWarning(type, debug, message)
+        /* Constructor for the TraversalWarning class, which takes the type of the warning, debug information, optionally the template of a message and the arguments to fill in it. */
+        TraversalWarning(WarningType type, const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ParseWarning(type, debug, format, args)
         {}
         
     };
@@ -161,9 +178,12 @@ namespace ArgumentParser::Exceptions {
     /* Warning for when the meta-definition is actually empty. */
     class EmptyMetaWarning: public TraversalWarning {
     public:
+        /* The type of this warning. */
+        static constexpr WarningType warning_type = WarningType::empty_meta;
+
         /* Constructor for the EmptyMetaWarning, which only takes the debug info where the meta definition is declared. */
         EmptyMetaWarning(const DebugInfo& debug) :
-            TraversalWarning(WarningType::empty_meta, debug, "Empty meta-definition encountered; consider removing it")
+            TraversalWarning(warning_type, debug, "Empty meta-definition encountered; consider removing it")
         {}
 
         /* Allows the EmptyMetaWarning to be copied polymorphically. */
@@ -173,12 +193,15 @@ namespace ArgumentParser::Exceptions {
     /* Warning for when a certain property is referenced zero times, nor has any special meaning to the compiler. */
     class UnusedPropertyWarning: public TraversalWarning {
     public:
+        /* The type of this warning. */
+        static constexpr WarningType warning_type = WarningType::unused_property;
+
         /* The identifier of the property that wasn't referenced. */
         const std::string identifier;
 
         /* Constructor for the UnusedPropertyWarning, which only takes the debug info where the property is declared and its identifier. */
         UnusedPropertyWarning(const DebugInfo& debug, const std::string& identifier) :
-            TraversalWarning(WarningType::unused_property, debug, "Property is neither used by the compiler, nor referenced; consider removing it"),
+            TraversalWarning(warning_type, debug, "Property is neither used by the compiler, nor referenced; consider removing it"),
             identifier(identifier)
         {}
 
@@ -192,9 +215,9 @@ namespace ArgumentParser::Exceptions {
     /* Baseclass exception for all Traversal notes accompanying errors or warnings. */
     class TraversalNote: public ParseNote {
     public:
-        /* Constructor for the TraversalNote class, which takes debug information and optionally a message. */
-        TraversalNote(const DebugInfo& debug, const std::string& message = "") :
-            ParseNote(debug, message)
+        /* Constructor for the TraversalNote class, which takes debug information, optionally the template of a message and the arguments to fill in it. */
+        TraversalNote(const DebugInfo& debug, const char* format = "", const std::vector<std::string>& args = {}) :
+            ParseNote(debug, format, args)
         {}
         
     };
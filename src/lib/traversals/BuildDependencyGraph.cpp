@@ -0,0 +1,415 @@
+/* BUILD DEPENDENCY GRAPH.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 15:02:20
+ * Last edited:
+ *   18/10/2026, 19:23:05
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Builds a graph of which definitions and properties depend on which
+ *   others, based on the links made by the check_references traversal. A
+ *   definition depends on its own properties and on the typedefs it uses,
+ *   while a property depends on the properties it references. The graph
+ *   can be walked in both directions, ordered topologically and checked
+ *   for cycles.
+**/
+
+#include <algorithm>
+#include <deque>
+
+#include "ADLTypes.hpp"
+#include "ADLReference.hpp"
+#include "ADLDefinition.hpp"
+#include "ADLConfig.hpp"
+#include "ADLVisitor.hpp"
+#include "TraversalExceptions.hpp"
+#include "BuildDependencyGraph.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** HELPER STRUCTS *****/
+/* A vertex that Tarjan's algorithm is visiting, together with how far it got through its dependencies. */
+struct TarjanFrame {
+    /* The vertex being visited. */
+    size_t vertex;
+    /* The index of the next dependency to look at. */
+    size_t next;
+};
+
+/* State for finding the strongly connected components of the graph with Tarjan's algorithm. */
+struct TarjanState {
+    /* The graph we search. */
+    const DependencyGraph& graph;
+    /* The order in which each vertex was first visited, or DependencyGraph::none if it wasn't yet. */
+    std::vector<size_t> order;
+    /* The lowest order reachable from each vertex while it's on the stack. */
+    std::vector<size_t> low;
+    /* Whether each vertex is currently on the stack. */
+    std::vector<bool> on_stack;
+    /* The stack of vertices whose component isn't known yet. */
+    std::vector<size_t> stack;
+    /* The number of vertices visited so far. */
+    size_t counter;
+    /* The components found so far that form a cycle. */
+    std::vector<std::vector<size_t>> cycles;
+};
+
+
+
+
+
+/***** HELPER FUNCTIONS *****/
+/* Returns a readable name for the given definition, which is the identifier it's declared with. */
+static std::string definition_label(const ADLDefinition* definition) {
+    if (definition->identifier != nullptr) { return definition->identifier->identifier; }
+    if (definition->longlabel != nullptr) { return definition->longlabel->identifier; }
+    if (definition->shortlabel != nullptr) { return definition->shortlabel->identifier; }
+    return nodetype_name.at(definition->type);
+}
+
+/* Writes the given string to the given output stream as a quoted DOT-string. */
+static std::ostream& print_quoted(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (size_t i = 0; i < str.size(); i++) {
+        if (str[i] == '"' || str[i] == '\\') { os << '\\'; }
+        os << str[i];
+    }
+    return os << '"';
+}
+
+/* Visits the given vertex and everything reachable from it as part of Tarjan's algorithm, collecting the components that form a cycle. Keeps its own stack of frames instead of recursing, since a chain of dependencies can be as long as the file. */
+static void tarjan_visit(TarjanState& state, size_t root) {
+    std::vector<TarjanFrame> frames;
+    frames.push_back({ root, 0 });
+    while (!frames.empty()) {
+        TarjanFrame& frame = frames.back();
+        size_t vertex = frame.vertex;
+
+        // Give the vertex its order the first time we see it
+        if (frame.next == 0) {
+            state.order[vertex] = state.counter;
+            state.low[vertex] = state.counter;
+            ++state.counter;
+            state.stack.push_back(vertex);
+            state.on_stack[vertex] = true;
+        }
+
+        // Visit the next dependency that we haven't seen yet, keeping track of the lowest order we can reach
+        const std::vector<size_t>& dependencies = state.graph.get_dependencies(vertex);
+        bool descended = false;
+        while (frame.next < dependencies.size()) {
+            size_t dependency = dependencies[frame.next++];
+            if (state.order[dependency] == DependencyGraph::none) {
+                frames.push_back({ dependency, 0 });
+                descended = true;
+                break;
+            } else if (state.on_stack[dependency]) {
+                state.low[vertex] = std::min(state.low[vertex], state.order[dependency]);
+            }
+        }
+        if (descended) { continue; }
+
+        // All dependencies are done; if we're the root of a component, pop it off the stack
+        if (state.low[vertex] == state.order[vertex]) {
+            std::vector<size_t> component;
+            size_t member;
+            do {
+                member = state.stack.back();
+                state.stack.pop_back();
+                state.on_stack[member] = false;
+                component.push_back(member);
+            } while (member != vertex);
+
+            // It's only a cycle if it has more than one vertex, or if the vertex depends on itself
+            if (component.size() > 1 || std::find(dependencies.begin(), dependencies.end(), vertex) != dependencies.end()) {
+                std::sort(component.begin(), component.end());
+                state.cycles.push_back(component);
+            }
+        }
+
+        // Return to the vertex that depends on us, passing on the lowest order we could reach
+        frames.pop_back();
+        if (!frames.empty()) {
+            size_t dependent = frames.back().vertex;
+            state.low[dependent] = std::min(state.low[dependent], state.low[vertex]);
+        }
+    }
+}
+
+/* Returns a readable version of the shortest path from the first vertex in the given cycle back to itself, like 'a.pattern -> b.pattern -> a.pattern'. */
+static std::string cycle_path(const DependencyGraph& graph, const std::vector<size_t>& cycle) {
+    // Search backwards from the start, only through the vertices in the cycle
+    size_t start = cycle[0];
+    std::unordered_map<size_t, size_t> next;
+    std::deque<size_t> todo = { start };
+    while (!todo.empty() && next.find(start) == next.end()) {
+        size_t vertex = todo.front();
+        todo.pop_front();
+        const std::vector<size_t>& dependents = graph.get_dependents(vertex);
+        for (size_t i = 0; i < dependents.size(); i++) {
+            size_t dependent = dependents[i];
+            if (next.find(dependent) != next.end() || !std::binary_search(cycle.begin(), cycle.end(), dependent)) { continue; }
+            next[dependent] = vertex;
+            todo.push_back(dependent);
+        }
+    }
+
+    // Walk the path forwards to print it
+    std::string result = graph.label(start);
+    size_t vertex = start;
+    do {
+        vertex = next.at(vertex);
+        result += " -> " + graph.label(vertex);
+    } while (vertex != start);
+    return result;
+}
+
+
+
+
+
+/***** DEPENDENCYGRAPH CLASS *****/
+
+/* Default constructor for the DependencyGraph class. */
+DependencyGraph::DependencyGraph() :
+    n_edges(0)
+{}
+
+
+
+/* Adds a vertex for the given definition or property node if it has none yet. If an owner is given, it's remembered as the vertex of the definition the property belongs to. Returns the vertex of the node either way. */
+size_t DependencyGraph::add(ADLNode* node, size_t owner) {
+    // Try to insert it with the next free vertex; if that fails, it already has one
+    std::pair<std::unordered_map<const ADLNode*, size_t>::iterator, bool> result = this->indices.insert({ node, this->nodes.size() });
+    if (result.second) {
+        this->nodes.push_back(node);
+        this->dependencies.push_back({});
+        this->dependents.push_back({});
+        this->owners.push_back(DependencyGraph::none);
+    }
+
+    // Properties may have been added by a reference before we knew their definition
+    if (owner != DependencyGraph::none) { this->owners[result.first->second] = owner; }
+    return result.first->second;
+}
+
+/* Marks that the first vertex depends on the second one. Edges that already exist are not added again. */
+void DependencyGraph::depend(size_t vertex, size_t dependency) {
+    std::vector<size_t>& dependencies = this->dependencies[vertex];
+    if (std::find(dependencies.begin(), dependencies.end(), dependency) != dependencies.end()) { return; }
+    dependencies.push_back(dependency);
+    this->dependents[dependency].push_back(vertex);
+    ++this->n_edges;
+}
+
+
+
+/* Returns the vertex of the given node, or DependencyGraph::none if it isn't in the graph. */
+size_t DependencyGraph::index(const ADLNode* node) const {
+    std::unordered_map<const ADLNode*, size_t>::const_iterator iter = this->indices.find(node);
+    return iter != this->indices.end() ? iter->second : DependencyGraph::none;
+}
+
+
+
+/* Returns all vertices the given vertex depends on, directly or indirectly, in breadth-first order. */
+std::vector<size_t> DependencyGraph::transitive_dependencies(size_t vertex) const {
+    std::vector<size_t> result;
+    std::vector<bool> seen(this->nodes.size(), false);
+    seen[vertex] = true;
+
+    // Use the result itself as the queue
+    result.insert(result.end(), this->dependencies[vertex].begin(), this->dependencies[vertex].end());
+    for (size_t i = 0; i < result.size(); i++) { seen[result[i]] = true; }
+    for (size_t i = 0; i < result.size(); i++) {
+        const std::vector<size_t>& next = this->dependencies[result[i]];
+        for (size_t j = 0; j < next.size(); j++) {
+            if (!seen[next[j]]) {
+                seen[next[j]] = true;
+                result.push_back(next[j]);
+            }
+        }
+    }
+    return result;
+}
+
+/* Returns all vertices that depend on the given vertex, directly or indirectly, in breadth-first order. */
+std::vector<size_t> DependencyGraph::transitive_dependents(size_t vertex) const {
+    std::vector<size_t> result;
+    std::vector<bool> seen(this->nodes.size(), false);
+    seen[vertex] = true;
+
+    // Use the result itself as the queue
+    result.insert(result.end(), this->dependents[vertex].begin(), this->dependents[vertex].end());
+    for (size_t i = 0; i < result.size(); i++) { seen[result[i]] = true; }
+    for (size_t i = 0; i < result.size(); i++) {
+        const std::vector<size_t>& next = this->dependents[result[i]];
+        for (size_t j = 0; j < next.size(); j++) {
+            if (!seen[next[j]]) {
+                seen[next[j]] = true;
+                result.push_back(next[j]);
+            }
+        }
+    }
+    return result;
+}
+
+
+
+/* Returns the vertices in an order where each comes after everything it depends on. Vertices that are part of a cycle, or that depend on one, are left out. */
+std::vector<size_t> DependencyGraph::topological_order() const {
+    // Count how many dependencies each vertex is still waiting on, and start with those without any
+    std::vector<size_t> waiting(this->nodes.size());
+    std::vector<size_t> result;
+    result.reserve(this->nodes.size());
+    for (size_t i = 0; i < this->nodes.size(); i++) {
+        waiting[i] = this->dependencies[i].size();
+        if (waiting[i] == 0) { result.push_back(i); }
+    }
+
+    // Use the result itself as the queue; each vertex is done once the last of its dependencies is
+    for (size_t i = 0; i < result.size(); i++) {
+        const std::vector<size_t>& next = this->dependents[result[i]];
+        for (size_t j = 0; j < next.size(); j++) {
+            if (--waiting[next[j]] == 0) { result.push_back(next[j]); }
+        }
+    }
+    return result;
+}
+
+/* Returns each cycle in the graph as the (sorted) list of vertices that are part of it. Cycles that share a vertex are returned as one. */
+std::vector<std::vector<size_t>> DependencyGraph::cycles() const {
+    TarjanState state({ *this, std::vector<size_t>(this->nodes.size(), DependencyGraph::none), std::vector<size_t>(this->nodes.size(), 0), std::vector<bool>(this->nodes.size(), false), {}, 0, {} });
+    for (size_t i = 0; i < this->nodes.size(); i++) {
+        if (state.order[i] == DependencyGraph::none) { tarjan_visit(state, i); }
+    }
+    return state.cycles;
+}
+
+
+
+/* Returns a readable name for the given vertex, like '<uint>' for a definition or '<uint>.pattern' for a property. */
+std::string DependencyGraph::label(size_t vertex) const {
+    ADLNode* node = this->nodes[vertex];
+    if (node->type == NodeType::config) {
+        // Prefix the property with the definition it belongs to, if we saw it
+        if (this->owners[vertex] == DependencyGraph::none) { return "." + ((ADLConfig*) node)->param; }
+        return definition_label((ADLDefinition*) this->nodes[this->owners[vertex]]) + "." + ((ADLConfig*) node)->param;
+    }
+    return definition_label((ADLDefinition*) node);
+}
+
+/* Writes the graph to the given output stream in the DOT-format, listing the vertices in topological order first. */
+std::ostream& DependencyGraph::print(std::ostream& os) const {
+    // Collect the order, appending anything that was left out because of cycles
+    std::vector<size_t> order = this->topological_order();
+    std::vector<bool> listed(this->nodes.size(), false);
+    for (size_t i = 0; i < order.size(); i++) { listed[order[i]] = true; }
+    for (size_t i = 0; i < this->nodes.size(); i++) {
+        if (!listed[i]) { order.push_back(i); }
+    }
+
+    // Write the vertices, then the edges from each vertex to its dependencies
+    os << "digraph dependencies {" << endl;
+    for (size_t i = 0; i < order.size(); i++) {
+        os << "    n" << order[i] << " [label=";
+        print_quoted(os, this->label(order[i]));
+        os << "];" << endl;
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        const std::vector<size_t>& dependencies = this->dependencies[order[i]];
+        for (size_t j = 0; j < dependencies.size(); j++) {
+            os << "    n" << order[i] << " -> n" << dependencies[j] << ";" << endl;
+        }
+    }
+    return os << "}" << endl;
+}
+
+
+
+
+
+/***** VISITORS *****/
+/* Visitor that adds each definition & property it visits to the graph, together with the edges to what they depend on. */
+struct BuildDependencyGraphVisitor {
+    /* The graph we're building. */
+    DependencyGraph& graph;
+    /* The vertex of the definition we're currently in. */
+    size_t definition;
+    /* The vertex of the property we're currently in, or DependencyGraph::none if we're not in one. */
+    size_t property;
+
+    /* Main traversal function for the traversal. */
+    ADLNode* operator()(const char* trav_id, ADLNode* node) {
+        // Whatever we find in a property is what the property depends on; elsewhere, it's what the definition depends on
+        size_t owner = this->property != DependencyGraph::none ? this->property : this->definition;
+
+        switch (node->type) {
+            case NodeType::types:
+                {
+                    // Depend on each of the typedefs that we could link
+                    ADLTypes* types = (ADLTypes*) node;
+                    for (size_t i = 0; i < types->definitions.size(); i++) {
+                        if (types->definitions[i] != nullptr) { this->graph.depend(owner, this->graph.add(types->definitions[i])); }
+                    }
+                }
+                break;
+
+            case NodeType::reference:
+                // Depend on the property, if we could link it
+                if (((ADLReference*) node)->reference != nullptr) { this->graph.depend(owner, this->graph.add(((ADLReference*) node)->reference)); }
+                break;
+
+            case NodeType::config:
+                {
+                    // The definition depends on its properties; look for references in the values
+                    size_t vertex = this->graph.add(node, this->definition);
+                    this->graph.depend(this->definition, vertex);
+                    this->property = vertex;
+                    visit_children(trav_id, node, build_dependency_graph_types, *this);
+                    this->property = DependencyGraph::none;
+                }
+                break;
+
+            default:
+                {
+                    // Add the definition, then go look for its properties and types
+                    size_t parent = this->definition;
+                    this->definition = this->graph.add(node);
+                    visit_children(trav_id, node, build_dependency_graph_types, *this);
+                    this->definition = parent;
+                }
+                break;
+        }
+
+        // We won't change nodes, so always return the OG one
+        return node;
+    }
+};
+
+
+
+
+
+/***** ENTRY POINT *****/
+/* The traversal function that builds the dependency graph of the given tree, logging an error for each cycle in it. The tree should have gone through the build_symbol_table and check_references traversals already. */
+DependencyGraph ArgumentParser::traversal_build_dependency_graph(ADLTree* tree) {
+    // Build the graph
+    DependencyGraph result;
+    BuildDependencyGraphVisitor visitor({ result, DependencyGraph::none, DependencyGraph::none });
+    visit(build_dependency_graph_id, tree, build_dependency_graph_types, visitor);
+
+    // Let the user know about any property that depends on itself
+    std::vector<std::vector<size_t>> cycles = result.cycles();
+    for (size_t i = 0; i < cycles.size(); i++) {
+        Exceptions::log(Exceptions::CyclicReferenceError(result[cycles[i][0]]->debug, cycle_path(result, cycles[i])));
+    }
+
+    // Done
+    return result;
+}
@@ -4,7 +4,7 @@
  * Created:
  *   01/01/2021, 16:07:21
  * Last edited:
- *   11/02/2021, 15:16:11
+ *   18/10/2026, 19:23:05
  * Auto updated?
  *   Yes
  *
@@ -18,68 +18,34 @@
 #include "ADLDefinition.hpp"
 #include "ADLOption.hpp"
 #include "ADLConfig.hpp"
+#include "ADLVisitor.hpp"
 #include "BuildSymbolTable.hpp"
 
 using namespace std;
 using namespace ArgumentParser;
 
 
-/***** TRAVERSAL FUNCTIONS *****/
-/* Main traversal function for the first traversal. */
-static ADLNode* traversal_function(const char* trav_id, ADLNode* node, void* vsymbol_table) {
-    SymbolTable* symbol_table = (SymbolTable*) vsymbol_table;
-
-    // Do different things depending on if we're definitions or property statements
-    if (node->type == NodeType::config) {
-        // Get the parent of the node (skip the ADLConfigs list)
-        ADLDefinition* parent = (ADLDefinition*) node->parent->parent;
-        
-        // Add this node to the symbol table
-        parent->symbol_table.add(((ADLConfig*) node)->param.c_str(), node);
-    } else {
-        // Add one entry for each identifier that works
-        ADLDefinition* def = (ADLDefinition*) node;
-        if (def->identifier != nullptr) { symbol_table->add(def->identifier->identifier, node); }
-        if (def->shortlabel != nullptr) { symbol_table->add(def->shortlabel->identifier, node); }
-        if (def->longlabel != nullptr) { symbol_table->add(def->longlabel->identifier, node); }
-        
-        // Continue with the recursion
-        node->traverse_recurse(
-            trav_id,
-            build_symbol_table_types,
-            traversal_function,
-            vsymbol_table
-        );
-    }
-
-    // Simply return the current node, since we won't be replacing any
-    return node;
+/***** HELPER FUNCTIONS *****/
+/* Adds the given definition to the given (main) symbol table, once for each identifier it answers to. */
+void ArgumentParser::register_definition(ADLDefinition* definition, SymbolTable& symbol_table) {
+    if (definition->identifier != nullptr) { symbol_table.add(definition->identifier->identifier, definition); }
+    if (definition->shortlabel != nullptr) { symbol_table.add(definition->shortlabel->identifier, definition); }
+    if (definition->longlabel != nullptr) { symbol_table.add(definition->longlabel->identifier, definition); }
 }
 
+/* Adds the given property to the symbol table of the given definition, which is the one it belongs to. */
+void ArgumentParser::register_property(ADLDefinition* definition, ADLConfig* config) {
+    // Add this node to the symbol table
+    definition->symbol_table.add(config->param.c_str(), config);
+}
 
-
-
-
-/***** ENTRY POINT *****/
-/* The traversal function for the first traversal, that builds a symbol table from the parsed AST. */
-SymbolTable ArgumentParser::traversal_build_symbol_table(ADLTree* tree) {
-    // Prepare the any class that we'll pass around
-    SymbolTable result;
-
-    // Call our own traversal function
-    tree->traverse(
-        build_symbol_table_id,
-        build_symbol_table_types,
-        traversal_function,
-        (void*) &result
-    );
-
-    // Once done, merge any 'meta' divs
+/* Merges the symbol tables of all meta definitions in the given (main) symbol table into that of the first one, removing the others from the main table. */
+void ArgumentParser::merge_metas(SymbolTable& symbol_table) {
     ADLDefinition* first_meta = nullptr;
     std::vector<size_t> duplicate_metas;
-    duplicate_metas.reserve(result.size());
-    for (size_t i = 0; i < result.size(); i++) {
-        SymbolTableEntry& entry = result[i];
+    duplicate_metas.reserve(symbol_table.size());
+    for (size_t i = 0; i < symbol_table.size(); i++) {
+        SymbolTableEntry& entry = symbol_table[i];
         if (entry.node_type == NodeType::meta) {
             // Set it as the first meta if we didn't set one already
             if (first_meta == nullptr) {
@@ -98,9 +64,65 @@ SymbolTable ArgumentParser::traversal_build_symbol_table(ADLTree* tree) {
 
     // Remove the metas we marked to remove so
     for (size_t i = 0; i < duplicate_metas.size(); i++) {
-        result.remove(duplicate_metas[i]);
+        symbol_table.remove(duplicate_metas[i]);
+    }
+}
+
+
+
+
+
+/***** VISITORS *****/
+/* Visitor for the first traversal, which adds each definition & property it visits to the correct symbol table. */
+struct BuildSymbolTableVisitor {
+    /* The main symbol table, to which definitions are added. */
+    SymbolTable& symbol_table;
+    /* The definition whose properties we're currently visiting. Tracked on the way down, since the parent of a node shared with a cloned tree may be in the other tree. */
+    ADLDefinition* definition;
+
+    /* Main traversal function for the first traversal. */
+    ADLNode* operator()(const char* trav_id, ADLNode* node) {
+        // Do different things depending on if we're definitions or property statements
+        if (node->type == NodeType::config) {
+            register_property(this->definition, (ADLConfig*) node);
+        } else {
+            // Add one entry for each identifier that works
+            register_definition((ADLDefinition*) node, this->symbol_table);
+            this->definition = (ADLDefinition*) node;
+
+            // Continue with the recursion
+            visit_children(trav_id, node, build_symbol_table_types, *this);
+        }
+
+        // Simply return the current node, since we won't be replacing any
+        return node;
     }
+};
+
+
+
+
+
+/***** ENTRY POINT *****/
+/* The traversal function for the first traversal, that builds a symbol table from the parsed AST. */
+SymbolTable ArgumentParser::traversal_build_symbol_table(ADLTree* tree) {
+    // Prepare the any class that we'll pass around
+    SymbolTable result;
+
+    // Call our own visitor
+    BuildSymbolTableVisitor visitor({ result, nullptr });
+    visit(build_symbol_table_id, tree, build_symbol_table_types, visitor);
+
+    // Once done, merge any 'meta' divs
+    merge_metas(result);
 
     // We're done
     return result;
 }
+
+/* Runs the first traversal for a single definition only, adding its identifiers to the given (main) symbol table and building its own nested one. Note that meta definitions are not merged. */
+void ArgumentParser::traversal_build_symbol_table(ADLDefinition* definition, SymbolTable& symbol_table) {
+    // Simply call the visitor on the definition directly
+    BuildSymbolTableVisitor visitor({ symbol_table, nullptr });
+    visitor(build_symbol_table_id, definition);
+}
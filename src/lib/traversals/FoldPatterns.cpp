@@ -0,0 +1,231 @@
+/* FOLD PATTERNS.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 15:15:53
+ * Last edited:
+ *   18/10/2026, 19:28:35
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Folds the values of each .pattern property that concatenates strings,
+ *   regular expressions and references to other properties into a single
+ *   regular expression. Properties are evaluated in dependency order, so
+ *   the folded value of each property only has to be computed once.
+**/
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ADLDefinition.hpp"
+#include "ADLConfig.hpp"
+#include "ADLValues.hpp"
+#include "ADLString.hpp"
+#include "ADLRegex.hpp"
+#include "ADLReference.hpp"
+#include "ADLVisitor.hpp"
+#include "FoldPatterns.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** HELPER FUNCTIONS *****/
+/* Returns the given string as a regular expression that matches it literally. */
+static std::string escape(const std::string& str) {
+    std::string result;
+    result.reserve(str.size());
+    for (size_t i = 0; i < str.size(); i++) {
+        switch (str[i]) {
+            case '\\': case '^': case '$': case '.': case '|': case '?': case '*': case '+':
+            case '(': case ')': case '[': case ']': case '{': case '}':
+                result += '\\';
+                break;
+
+            default:
+                break;
+        }
+        result += str[i];
+    }
+    return result;
+}
+
+/* Returns whether the given regular expression has alternatives at its top level, i.e., a '|' that isn't escaped, in a group or in a character class. Such expressions have to be grouped before anything is put next to them. */
+static bool has_alternatives(const std::string& regex) {
+    size_t depth = 0;
+    for (size_t i = 0; i < regex.size(); i++) {
+        switch (regex[i]) {
+            case '\\':
+                // Skip whatever is escaped
+                ++i;
+                break;
+
+            case '[':
+                // Skip the character class, where a ']' right at the start (after an optional '^') is part of it
+                ++i;
+                if (i < regex.size() && regex[i] == '^') { ++i; }
+                if (i < regex.size() && regex[i] == ']') { ++i; }
+                while (i < regex.size() && regex[i] != ']') {
+                    if (regex[i] == '\\') { ++i; }
+                    ++i;
+                }
+                break;
+
+            case '(':
+                ++depth;
+                break;
+
+            case ')':
+                if (depth > 0) { --depth; }
+                break;
+
+            case '|':
+                if (depth == 0) { return true; }
+                break;
+
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+/* Removes the given reference from the list of references of the property it's linked to, which belongs to the given definition. */
+static void unreference(ADLDefinition* definition, ADLReference* reference) {
+    SymbolTableEntry* entry = definition->symbol_table.find(reference->reference->param);
+    if (entry == nullptr) { return; }
+    for (size_t i = 0; i < entry->references.size(); i++) {
+        if (entry->references[i] == reference) {
+            entry->references.erase(entry->references.begin() + i);
+            return;
+        }
+    }
+}
+
+
+
+
+
+/***** VISITORS *****/
+/* Visitor that replaces the values of each folded property with a single regular expression, and drops the references that disappear with them from the symbol tables of the definitions they referenced. Replacing nodes by returning new ones, instead of changing them directly, means a definition or property shared with a cloned tree is copied first. */
+struct FoldPatternsVisitor {
+    /* The folded regular expression for each values node to replace. */
+    const std::unordered_map<const ADLNode*, std::string>& folded;
+    /* For each definition, the references to its properties that are folded away. */
+    const std::unordered_map<const ADLNode*, std::vector<ADLReference*>>& dropped;
+
+    /* Main traversal function for the traversal. */
+    ADLNode* operator()(const char* trav_id, ADLNode* node) {
+        if (node->type == NodeType::values) {
+            std::unordered_map<const ADLNode*, std::string>::const_iterator iter = this->folded.find(node);
+            if (iter == this->folded.end()) { return node; }
+            return new ADLValues(node->debug, new ADLRegex(node->debug, iter->second));
+        }
+
+        // Replace the values in the definition first, which copies it if it's shared and any of them are replaced
+        ADLNode* result = visit_children(trav_id, node, fold_patterns_types, *this);
+        std::unordered_map<const ADLNode*, std::vector<ADLReference*>>::const_iterator iter = this->dropped.find(node);
+        if (iter == this->dropped.end()) { return result; }
+
+        // Its symbol table changes too, so make sure we have a copy of our own to change
+        if (result == node && (ADLBranch::in_shared || node->refs > 1)) { result = node->copy(); }
+        for (size_t i = 0; i < iter->second.size(); i++) {
+            unreference((ADLDefinition*) result, iter->second[i]);
+        }
+        return result;
+    }
+};
+
+
+
+
+
+/***** ENTRY POINT *****/
+/* Replaces the values of each .pattern property in the given tree that consists of strings, regular expressions and references to such properties with one regular expression, using the given dependency graph of the tree to evaluate them in order. Returns the number of properties that were folded. The tree should have gone through the build_symbol_table and check_references traversals already. */
+size_t ArgumentParser::traversal_fold_patterns(ADLTree* tree, const DependencyGraph& dependencies) {
+    // The folded value of each property we've seen so far, and whether it could be folded at all
+    std::vector<std::string> folded(dependencies.size());
+    std::vector<bool> foldable(dependencies.size(), false);
+    // The values nodes to replace, with the expression to replace them with, and the references that go away with them
+    std::unordered_map<const ADLNode*, std::string> replacements;
+    std::unordered_map<const ADLNode*, std::vector<ADLReference*>> dropped;
+
+    // Go through the properties such that anything a property references has been folded before it
+    size_t n_folded = 0;
+    std::vector<size_t> order = dependencies.topological_order();
+    for (size_t i = 0; i < order.size(); i++) {
+        size_t vertex = order[i];
+        if (dependencies[vertex]->type != NodeType::config) { continue; }
+        ADLConfig* config = (ADLConfig*) dependencies[vertex];
+        ADLValues* values = config->get_node<ADLValues>(0);
+
+        // Evaluate each of the values, stopping at the first one we can't evaluate
+        std::vector<std::string> parts;
+        parts.reserve(values->size());
+        bool valid = true;
+        bool chained = values->size() > 1;
+        for (size_t j = 0; valid && j < values->size(); j++) {
+            ADLNode* value = values->children[j];
+            switch (value->type) {
+                case NodeType::string:
+                    parts.push_back(escape(((ADLString*) value)->value));
+                    break;
+
+                case NodeType::regex:
+                    parts.push_back(((ADLRegex*) value)->value);
+                    break;
+
+                case NodeType::reference:
+                    {
+                        // Use the memoized value of the property
+                        ADLConfig* target = ((ADLReference*) value)->reference;
+                        size_t target_vertex = target != nullptr ? dependencies.index(target) : DependencyGraph::none;
+                        if (target_vertex == DependencyGraph::none || !foldable[target_vertex]) { valid = false; break; }
+                        parts.push_back(folded[target_vertex]);
+                        chained = true;
+                    }
+                    break;
+
+                default:
+                    // Numbers, snippets and the like aren't patterns
+                    valid = false;
+                    break;
+            }
+        }
+        if (!valid) { continue; }
+
+        // Concatenate the parts, grouping those with alternatives if there is more than one so the alternatives don't swallow their neighbours
+        std::string result;
+        for (size_t j = 0; valid && j < parts.size(); j++) {
+            bool group = parts.size() > 1 && has_alternatives(parts[j]);
+            if (result.size() + parts[j].size() + (group ? 4 : 0) > fold_patterns_max_length) { valid = false; break; }
+            if (group) { result += "(?:" + parts[j] + ")"; }
+            else { result += parts[j]; }
+        }
+        // Leave properties that grow too long as they are, which means the ones referencing them aren't folded either
+        if (!valid) { continue; }
+        folded[vertex] = result;
+        foldable[vertex] = true;
+
+        // Only patterns that are built from more than one part are worth replacing
+        if (!chained || config->param != "pattern") { continue; }
+        for (size_t j = 0; j < values->size(); j++) {
+            if (values->children[j]->type != NodeType::reference) { continue; }
+            ADLReference* reference = values->get_node<ADLReference>(j);
+            dropped[dependencies[dependencies.owner(dependencies.index(reference->reference))]].push_back(reference);
+        }
+        replacements[values] = result;
+        ++n_folded;
+    }
+
+    // Replace the values of the folded properties in one go
+    if (!replacements.empty()) {
+        FoldPatternsVisitor visitor({ replacements, dropped });
+        visit(fold_patterns_id, tree, fold_patterns_types, visitor);
+    }
+
+    // Done
+    return n_folded;
+}
@@ -0,0 +1,281 @@
+/* REPARSE DEFINITION.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 13:44:10
+ * Last edited:
+ *   18/10/2026, 19:33:02
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Incrementally updates an already parsed & analysed ADLTree after its
+ *   root file has changed. Only the toplevel definition that contains the
+ *   change is parsed again, after which it is spliced into the tree and
+ *   its entries in the symbol tables are patched in-place.
+**/
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_set>
+
+#include "SourceManager.hpp"
+#include "ADLTokenizer.hpp"
+#include "ADLParser.hpp"
+#include "ADLTypes.hpp"
+#include "ADLTypeDef.hpp"
+#include "ADLReference.hpp"
+#include "ADLDefinition.hpp"
+#include "ADLConfig.hpp"
+#include "SuppressionList.hpp"
+#include "TraversalExceptions.hpp"
+#include "BuildSymbolTable.hpp"
+#include "CheckReferences.hpp"
+#include "ReparseDefinition.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** HELPER STRUCTS *****/
+/* Position in a source file, as a (line, column) pair. */
+struct Position {
+    /* The line number of the position. */
+    size_t line;
+    /* The column number of the position. */
+    size_t col;
+
+    /* Compares two positions by the order in which they appear in the file. */
+    inline bool operator<=(const Position& other) const { return this->line < other.line || (this->line == other.line && this->col <= other.col); }
+};
+
+/* State for the traversal that shifts the debug information of all definitions following the reparsed one. */
+struct ShiftState {
+    /* The line on which the old definition ended; nodes starting or stopping on it also shift columns. */
+    size_t line;
+    /* The number of lines to shift. */
+    long lines;
+    /* The number of columns to shift for nodes on the old definition's last line. */
+    long cols;
+};
+
+
+
+
+
+/***** HELPER FUNCTIONS *****/
+/* Traversal function that adds the given types or reference node to the given set. Used to find which references live in a subtree from the top down, since the parent of a node shared with a cloned tree may be in the other tree. */
+static ADLNode* collect_function(const char*, ADLNode* node, void* vnodes) {
+    ((std::unordered_set<ADLNode*>*) vnodes)->insert(node);
+    return node;
+}
+
+/* Removes all occurrences of the given node from the list of references of the given entry. */
+static void unreference(SymbolTableEntry& entry, ADLNode* node) {
+    entry.references.erase(std::remove(entry.references.begin(), entry.references.end(), node), entry.references.end());
+}
+
+/* Traversal function that unlinks the given types or reference node from the entries it is registered at. */
+static ADLNode* detach_function(const char*, ADLNode* node, void* vsymbol_table) {
+    SymbolTable* symbol_table = (SymbolTable*) vsymbol_table;
+
+    if (node->type == NodeType::types) {
+        // Remove ourselves from the references of every type we linked to
+        ADLTypes* types = (ADLTypes*) node;
+        for (size_t i = 0; i < types->definitions.size(); i++) {
+            if (types->definitions[i] == nullptr) { continue; }
+            SymbolTableEntry* entry = symbol_table->find(types->get_node<ADLIdentifier>(i)->identifier);
+            if (entry != nullptr) { unreference(*entry, node); }
+        }
+    } else {
+        // Remove ourselves from the references of the property we linked to
+        ADLReference* reference = (ADLReference*) node;
+        SymbolTableEntry* entry = reference->reference != nullptr ? symbol_table->find(reference->definition->identifier) : nullptr;
+        if (entry != nullptr) {
+            SymbolTableEntry* pentry = ((ADLDefinition*) entry->node)->symbol_table.find(reference->property->identifier);
+            if (pentry != nullptr) { unreference(*pentry, node); }
+        }
+    }
+
+    // We won't change nodes
+    return node;
+}
+
+/* Traversal function that shifts the debug information of each node it's called on. */
+static ADLNode* shift_function(const char* trav_id, ADLNode* node, void* vstate) {
+    ShiftState* state = (ShiftState*) vstate;
+
+    // Shift the columns first, since those are based on the old line number
+    if (node->debug.line1 == state->line) { node->debug.col1 += state->cols; }
+    if (node->debug.line2 == state->line) { node->debug.col2 += state->cols; }
+    node->debug.line1 += state->lines;
+    node->debug.line2 += state->lines;
+
+    // Go deeper
+    return node->traverse_recurse(trav_id, nt_all, shift_function, vstate);
+}
+
+
+
+
+
+/***** ENTRY POINT *****/
+/* Re-parses the toplevel definition in the given tree's root file that contains the changed byte range [offset, offset + length), where the range is given in terms of the file's new contents. The tree should have gone through the build_symbol_table and check_references traversals already. Returns true if the tree was successfully patched, or false if the change can't be handled incrementally (e.g., it spans multiple definitions, touches a macro or a meta definition, or contains errors). In the latter case, the tree is left untouched and the file should be parsed from scratch. Note that the change should be the only one since the tree was (re-)parsed, since the rest of the file is found by how much the file grew or shrunk. */
+bool ArgumentParser::reparse_definition(ADLTree* tree, size_t offset, size_t length) {
+    const std::string& filename = tree->debug.filenames[0];
+
+    // We need the old contents of the file to tell where the unchanged rest of it has moved to, which the source manager still has from when the tree was parsed
+    file_t source = source_manager.find(filename);
+    if (source == SourceManager::none) { return false; }
+    size_t old_length = source_manager.length(source);
+
+    // Find the last definition from the root file that starts before the change, which we can do in the old contents since everything before the change is the same
+    Position change_start;
+    source_manager.position(source, offset, change_start.line, change_start.col);
+    size_t index = tree->children.size();
+    for (size_t i = 0; i < tree->children.size(); i++) {
+        const DebugInfo& debug = tree->children[i]->debug;
+        if (debug.filenames.size() != 1) { continue; }
+        if (!(Position({ debug.line1, debug.col1 }) <= change_start)) { break; }
+        index = i;
+    }
+    if (index == tree->children.size()) { return false; }
+    ADLDefinition* old_def = (ADLDefinition*) tree->children[index];
+    if (old_def->type == NodeType::meta) { return false; }
+
+    // Note where the next definition from the root file started, since the new definition has to end before it does
+    size_t old_next = old_length;
+    for (size_t i = index + 1; i < tree->children.size(); i++) {
+        const DebugInfo& debug = tree->children[i]->debug;
+        if (debug.filenames.size() != 1) { continue; }
+        old_next = source_manager.offset(source, debug.line1, debug.col1);
+        break;
+    }
+
+    // Read the new file in its entirety into the source manager, so we can map the byte range to lines and columns (and diagnostics show the new contents)
+    std::ifstream file(filename);
+    if (!file.is_open()) { return false; }
+    source = source_manager.load(filename, file);
+    file.close();
+    if (source == SourceManager::none || offset + length > source_manager.length(source)) { return false; }
+
+    // Everything after the change moved by however much the file grew or shrunk, so the change may not have reached into the next definition
+    long delta = (long) source_manager.length(source) - (long) old_length;
+    if ((long) (offset + length) - delta < (long) offset || (long) (offset + length) - delta > (long) old_next) { return false; }
+
+    // Map the last changed byte to a position
+    Position change_end;
+    size_t last = length > 0 ? offset + length - 1 : offset;
+    source_manager.position(source, last, change_end.line, change_end.col);
+
+    // Parse the definition again, starting where the old one started, with its identifiers in the same table as the rest of the tree
+    InternTable::Scope intern_scope(tree->interns.get());
+    // Its suppressions go in a list of their own first, since the tree's list may only change once we know the new definition is any good
+    Exceptions::SuppressionList suppressions;
+    ADLDefinition* new_def;
+    {
+        Exceptions::SuppressionList::Scope suppression_scope(&suppressions);
+        std::ifstream* stream = new std::ifstream(filename);
+        stream->seekg(source_manager.offset(source, old_def->debug.line1, old_def->debug.col1));
+        Tokenizer in(stream, { filename }, old_def->debug.line1, old_def->debug.col1);
+        new_def = Parser::parse_definition(in, filename);
+    }
+    if (new_def == nullptr) { return false; }
+    // Make sure the change didn't spill over into what comes after it, that the definition didn't swallow the next one (e.g., because its closing bracket was removed), and that it didn't become a meta
+    size_t new_end = source_manager.offset(source, new_def->debug.line2, new_def->debug.col2);
+    if (new_def->type == NodeType::meta || !(change_end <= Position({ new_def->debug.line2, new_def->debug.col2 })) || (long) new_end >= (long) old_next + delta) {
+        delete new_def;
+        return false;
+    }
+
+    // Replace the suppressions within the old definition by the new ones, and let the ones that follow move along with the rest of the file
+    Exceptions::SuppressionList::Scope suppression_scope(tree->suppressions.get());
+    if (tree->suppressions != nullptr) { tree->suppressions->splice(old_def->debug, suppressions, new_def->debug.line2, new_def->debug.col2); }
+
+
+
+    // Collect the nodes outside of the old definition that reference it or one of its properties, before we forget about them
+    std::unordered_set<ADLNode*> inside;
+    old_def->traverse(check_references_id, check_references_types, collect_function, (void*) &inside);
+    std::vector<ADLNode*> type_refs;
+    for (size_t i = 0; i < tree->symbol_table.size(); i++) {
+        SymbolTableEntry& entry = tree->symbol_table[i];
+        if (entry.node != old_def) { continue; }
+        for (size_t j = 0; j < entry.references.size(); j++) {
+            if (inside.count(entry.references[j]) == 0) { type_refs.push_back(entry.references[j]); }
+        }
+    }
+    std::vector<ADLNode*> property_refs;
+    for (const SymbolTableEntry& entry : old_def->symbol_table) {
+        for (size_t j = 0; j < entry.references.size(); j++) {
+            if (inside.count(entry.references[j]) == 0) { property_refs.push_back(entry.references[j]); }
+        }
+    }
+
+    // Unlink the references made by the old definition to others
+    old_def->traverse(
+        check_references_id,
+        check_references_types,
+        detach_function,
+        (void*) &tree->symbol_table
+    );
+
+    // Remove the old definition from the main symbol table (going backwards to keep the indices valid)
+    for (size_t i = tree->symbol_table.size(); i-- > 0;) {
+        if (tree->symbol_table[i].node == old_def) { tree->symbol_table.remove(i); }
+    }
+
+    // Splice the new definition into the tree, and add it to the symbol table in the same way the first traversal does
+    tree->children[index] = new_def;
+    ++new_def->refs;
+    new_def->parent = tree;
+    traversal_build_symbol_table(new_def, tree->symbol_table);
+
+
+
+    // Relink the types that referenced the old definition
+    for (size_t i = 0; i < type_refs.size(); i++) {
+        ADLTypes* types = (ADLTypes*) type_refs[i];
+        for (size_t j = 0; j < types->definitions.size(); j++) {
+            if (types->definitions[j] != old_def) { continue; }
+
+            // See if the new definition still answers to this type
+            ADLIdentifier* id = types->get_node<ADLIdentifier>(j);
+            if (new_def->type == NodeType::type_def && new_def->has_identifier(id)) {
+                types->definitions[j] = (ADLTypeDef*) new_def;
+                tree->symbol_table.at(id->identifier).references.push_back(types);
+            } else {
+                types->definitions[j] = nullptr;
+                Exceptions::log(Exceptions::UnknownTypeError(id->debug, id->identifier));
+            }
+        }
+    }
+    // Relink the references that referenced one of the old definition's properties
+    for (size_t i = 0; i < property_refs.size(); i++) {
+        ADLReference* reference = (ADLReference*) property_refs[i];
+        reference->reference = nullptr;
+        SymbolTableEntry* pentry = new_def->has_identifier(reference->definition) ? new_def->symbol_table.find(reference->property->identifier) : nullptr;
+        if (pentry != nullptr) {
+            reference->reference = (ADLConfig*) pentry->node;
+            pentry->references.push_back(reference);
+        }
+    }
+
+    // Link the references made by the new definition itself
+    traversal_check_references(tree, new_def);
+
+
+
+    // Finally, shift everything that comes after the definition in the root file by however much the definition grew or shrunk
+    ShiftState state({ old_def->debug.line2, (long) new_def->debug.line2 - (long) old_def->debug.line2, (long) new_def->debug.col2 - (long) old_def->debug.col2 });
+    if (state.lines != 0 || state.cols != 0) {
+        for (size_t i = index + 1; i < tree->children.size(); i++) {
+            if (tree->children[i]->debug.filenames.size() != 1) { continue; }
+            tree->children[i]->traverse("reparse_definition", nt_all, shift_function, (void*) &state);
+        }
+    }
+
+    // The old definition is no longer needed (by this tree, at least)
+    ADLNode::release(old_def);
+    return true;
+}
@@ -0,0 +1,125 @@
+/* SEMANTIC ANALYSIS.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:17:17
+ * Last edited:
+ *   18/10/2026, 19:23:05
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Fuses the build_symbol_table and check_references traversals into a
+ *   single walk over the tree. Types and references are collected while
+ *   the symbol tables are built, and are linked in a linear pass over
+ *   that list once all definitions are known.
+**/
+
+#include <vector>
+
+#include "ADLTypes.hpp"
+#include "ADLReference.hpp"
+#include "ADLDefinition.hpp"
+#include "ADLConfig.hpp"
+#include "ADLVisitor.hpp"
+#include "SemanticAnalysis.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** HELPER FUNCTIONS *****/
+/* Merges the metas in the given tree's symbol table and then links the given types & references against it, in order. */
+static void resolve_pending(ADLTree* tree, const std::vector<ADLNode*>& pending) {
+    // Merge any 'meta' divs, like the first traversal does
+    merge_metas(tree->symbol_table);
+
+    // Now that every definition is known, link the types & references in one go
+    for (size_t i = 0; i < pending.size(); i++) {
+        ADLNode* node = pending[i];
+        if (node->type == NodeType::types) {
+            resolve_types((ADLTypes*) node, tree->symbol_table);
+        } else {
+            resolve_reference((ADLReference*) node, tree->symbol_table);
+        }
+    }
+}
+
+
+
+
+
+/***** VISITORS *****/
+/* Visitor for the fused traversal, which registers definitions & properties and remembers the types & references it sees for later. */
+struct SemanticAnalysisVisitor {
+    /* The main symbol table, to which definitions are added. */
+    SymbolTable& symbol_table;
+    /* The types & references that still have to be linked, in the order they appear in the tree. */
+    std::vector<ADLNode*> pending;
+    /* The definition whose properties we're currently visiting. Tracked on the way down, since the parent of a node shared with a cloned tree may be in the other tree. */
+    ADLDefinition* definition;
+
+    /* Main traversal function for the fused traversal. */
+    ADLNode* operator()(const char* trav_id, ADLNode* node) {
+        switch (node->type) {
+            case NodeType::types:
+            case NodeType::reference:
+                // These can only be linked once the symbol table is complete
+                this->pending.push_back(node);
+                break;
+
+            case NodeType::config:
+                // Register the property, then look for references in its values
+                register_property(this->definition, (ADLConfig*) node);
+                visit_children(trav_id, node, semantic_analysis_types, *this);
+                break;
+
+            default:
+                // Add one entry for each identifier that works, then continue with the recursion
+                register_definition((ADLDefinition*) node, this->symbol_table);
+                this->definition = (ADLDefinition*) node;
+                visit_children(trav_id, node, semantic_analysis_types, *this);
+                break;
+        }
+
+        // Simply return the current node, since we won't be replacing any
+        return node;
+    }
+};
+
+
+
+
+
+/***** ENTRY POINT *****/
+/* Builds the main symbol table (and those in definition nodes) of the given tree and links all (type-)references in it, with the same result as running traversal_build_symbol_table() and traversal_check_references() after each other but with only one walk over the tree. */
+void ArgumentParser::traversal_semantic_analysis(ADLTree* tree) {
+    // Build the symbol tables, collecting what to link on the go
+    SemanticAnalysisVisitor visitor({ tree->symbol_table, {}, nullptr });
+    visit(semantic_analysis_id, tree, semantic_analysis_types, visitor);
+
+    // Link everything we've collected
+    resolve_pending(tree, visitor.pending);
+}
+
+/* Does the same as traversal_semantic_analysis(tree), except that it streams through the given flattened version of the tree instead of walking it. */
+void ArgumentParser::traversal_semantic_analysis(ADLTree* tree, const ADLFlatTree& flat) {
+    // Since the flat tree is in pre-order, a single loop sees the nodes in the same order as the visitor does
+    std::vector<ADLNode*> pending;
+    ADLDefinition* definition = nullptr;
+    for (size_t i = 0; i < flat.size(); i++) {
+        NodeType type = flat.types[i];
+        if (type & check_references_types) {
+            pending.push_back(flat.nodes[i]);
+        } else if (type == NodeType::config) {
+            register_property(definition, flat.get_node<ADLConfig>(i));
+        } else if (type & nt_toplevel) {
+            // Properties always follow the definition they belong to
+            definition = flat.get_node<ADLDefinition>(i);
+            register_definition(definition, tree->symbol_table);
+        }
+    }
+
+    // Link everything we've collected
+    resolve_pending(tree, pending);
+}
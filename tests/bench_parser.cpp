@@ -0,0 +1,759 @@
+/* BENCH PARSER.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 14:21:37
+ * Last edited:
+ *   18/10/2026, 19:29:08
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Benchmarks the different stages of the compiler on a synthetic ADL
+ *   specification. Generates a set of ADL files with the given number of
+ *   definitions, include depth, snippet length and references, and then
+ *   measures the tokenizer, preprocessor, parser and both traversals
+ *   (separately, fused and on a flattened tree), building the dependency
+ *   graph (also of a single, very long chain of references) and folding
+ *   the patterns in dependency order (also of patterns that double in
+ *   length with each link), as well as the bare traversal and visitor
+ *   machinery and cloning a tree to change a single node in the copy.
+ *   Finally, it measures the rate at which warnings are logged,
+ *   both when parsing a deliberately noisy file and when logging (or
+ *   suppressing, everywhere or over spans of source) them directly, how
+ *   fast they're rendered with their source snippets, and when parsing
+ *   the noisy file on several threads at once. The last phase parses a
+ *   file of random bytes, which should stop as soon as the error limit is
+ *   reached. The results are written to stdout as JSON.
+**/
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <streambuf>
+#include <thread>
+#include <vector>
+#include <malloc.h>
+#include <sys/stat.h>
+
+#include "ADLTokenizer.hpp"
+#include "ADLPreprocessor.hpp"
+#include "ADLParser.hpp"
+#include "DiagnosticSink.hpp"
+#include "BuildSymbolTable.hpp"
+#include "CheckReferences.hpp"
+#include "SemanticAnalysis.hpp"
+#include "BuildDependencyGraph.hpp"
+#include "FoldPatterns.hpp"
+#include "ADLVisitor.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** ALLOCATION COUNTING *****/
+/* The number of allocations done since the last reset. Atomic, since the parallel phase allocates from several threads. */
+static std::atomic<size_t> n_allocations(0);
+/* The number of bytes allocated since the last reset. */
+static std::atomic<size_t> n_allocated_bytes(0);
+/* The number of bytes currently allocated. */
+static std::atomic<size_t> n_live_bytes(0);
+/* The highest number of bytes allocated at once since the last reset. */
+static std::atomic<size_t> n_peak_bytes(0);
+
+/* Global override of the new operator that counts the allocations and keeps track of the memory in use. */
+void* operator new(size_t size) {
+    void* result = malloc(size == 0 ? 1 : size);
+    if (result == nullptr) { throw std::bad_alloc(); }
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+    n_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    // Raise the peak if we went over it
+    size_t usable = malloc_usable_size(result);
+    size_t live = n_live_bytes.fetch_add(usable, std::memory_order_relaxed) + usable;
+    size_t peak = n_peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !n_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return result;
+}
+/* Global override of the new[] operator that counts the allocations. */
+void* operator new[](size_t size) { return operator new(size); }
+/* Global override of the delete operator to match the new operator. */
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) { return; }
+    n_live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    free(ptr);
+}
+/* Global override of the delete[] operator to match the new[] operator. */
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+/* Global override of the sized delete operator to match the new operator. */
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+/* Global override of the sized delete[] operator to match the new[] operator. */
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+
+
+
+
+/***** HELPER STRUCTS *****/
+/* Configuration of the synthetic specification and the benchmark. */
+struct Config {
+    /* The number of positionals, options and typedefs (each) to generate. */
+    size_t n_definitions;
+    /* The number of files in the include chain. */
+    size_t include_depth;
+    /* The number of lines in each generated snippet. */
+    size_t snippet_lines;
+    /* The number of references in each generated pattern. */
+    size_t n_references;
+    /* The number of empty traversals done over the tree in a single run of the traversal phase, the number of clones made in the clone phase and the number of warnings logged per definition in the warning phases. */
+    size_t n_traversals;
+    /* The number of typedefs in the chain of patterns that each reference the next. */
+    size_t chain_length;
+    /* The number of times each phase is repeated; the fastest run is reported. */
+    size_t repetitions;
+    /* The directory to generate the files in. */
+    std::string directory;
+};
+
+/* Measurements for a single phase. */
+struct Measurement {
+    /* The fastest time of the phase, in seconds. */
+    double seconds;
+    /* The number of items processed (tokens, reductions, ...) in a single run. */
+    size_t items;
+    /* The number of allocations done in a single run. */
+    size_t allocations;
+    /* The number of bytes allocated in a single run. */
+    size_t allocated_bytes;
+    /* The highest number of bytes allocated at once during a single run, on top of what was allocated before it. */
+    size_t peak_bytes;
+};
+
+/* Stream buffer that discards everything written to it, used to keep printed diagnostics from dominating the warning phases. */
+class NullBuffer : public std::streambuf {
+protected:
+    /* Discards a single character. */
+    virtual int overflow(int c) { return c; }
+    /* Discards a sequence of characters. */
+    virtual std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+
+
+
+
+/***** HELPER FUNCTIONS *****/
+/* Writes the synthetic specification to the configured directory. Returns the path of the root file. */
+static std::string generate(const Config& config) {
+    mkdir(config.directory.c_str(), 0755);
+
+    // First, write the include chain, where each file defines a type and includes the next one
+    for (size_t i = 0; i < config.include_depth; i++) {
+        std::ofstream file(config.directory + "/chain_" + std::to_string(i) + ".adl");
+        file << "<chain_" << i << "> {" << endl;
+        file << "    .name \"Chain type " << i << "\";" << endl;
+        file << "    .pattern " << (i == 0 ? std::string("r\"[0-9]+\"") : "<chain_" + std::to_string(i - 1) + ">.pattern") << ";" << endl;
+        file << "}" << endl << endl;
+        if (i + 1 < config.include_depth) {
+            file << "#include \"" << config.directory << "/chain_" << i + 1 << ".adl\"" << endl;
+        }
+    }
+
+    // Then, write the root file
+    std::string root = config.directory + "/root.adl";
+    std::ofstream file(root);
+    file << "#include stdtypes" << endl;
+    if (config.include_depth > 0) { file << "#include \"" << config.directory << "/chain_0.adl\"" << endl; }
+    file << endl << "meta {" << endl << "    .auto_help (false);" << endl << "}" << endl << endl;
+
+    // Typedefs, each with a long pattern and a long snippet. Each pattern references the previous type once, in chains of 16, since folding patterns that reference the same one several times grows exponentially
+    for (size_t i = 0; i < config.n_definitions; i++) {
+        file << "<type_" << i << "> {" << endl;
+        file << "    .name \"Type " << i << "\";" << endl;
+        file << "    .pattern";
+        for (size_t j = 0; j < config.n_references; j++) {
+            if (i % 16 > 0 && j == 1) { file << " <type_" << (i - 1) << ">.pattern"; }
+            else { file << " <uint32>.pattern"; }
+            if (j + 1 < config.n_references) { file << " \"-\""; }
+        }
+        if (config.n_references == 0) { file << " r\"[0-9]+\""; }
+        file << ";" << endl;
+        file << "    .source ++{" << endl;
+        for (size_t j = 0; j < config.snippet_lines; j++) {
+            file << "        value = value * 10 + (raw[" << j << "] - '0');" << endl;
+        }
+        file << "    }++;" << endl;
+        file << "}" << endl << endl;
+    }
+
+    // Positionals, which use the typedefs
+    for (size_t i = 0; i < config.n_definitions; i++) {
+        file << "pos_" << i << " <type_" << i << "> {" << endl;
+        file << "    .category \"Positionals\";" << endl;
+        file << "    .description \"Positional number " << i << ", generated for benchmarking.\";" << endl;
+        file << "    .index " << i << ";" << endl;
+        file << "    .ratio " << i << ".5;" << endl;
+        file << "}" << endl << endl;
+    }
+
+    // Options, which reference the positionals and the types
+    for (size_t i = 0; i < config.n_definitions; i++) {
+        if (i < 26) { file << "-" << (char) ('a' + i) << " "; }
+        file << "--option_" << i << " <type_" << i << "> <uint32> {" << endl;
+        file << "    .category pos_" << i << ".category;" << endl;
+        file << "    .description \"Option number " << i << "\" pos_" << i << ".description;" << endl;
+        file << "    .pattern <type_" << i << ">.pattern \",\" <uint32>.pattern;" << endl;
+        file << "}" << endl << endl;
+    }
+
+    return root;
+}
+
+/* Writes a specification to the configured directory with a single chain of typedefs, where the pattern of each references the pattern of the next. Returns the path of the file. */
+static std::string generate_chain(const Config& config) {
+    mkdir(config.directory.c_str(), 0755);
+
+    std::string path = config.directory + "/chain.adl";
+    std::ofstream file(path);
+    for (size_t i = 0; i < config.chain_length; i++) {
+        file << "<link_" << i << "> {" << endl;
+        file << "    .pattern ";
+        if (i + 1 < config.chain_length) { file << "<link_" << i + 1 << ">.pattern"; }
+        else { file << "r\"[0-9]+\""; }
+        file << ";" << endl;
+        file << "}" << endl;
+    }
+
+    return path;
+}
+
+/* Writes a specification to the configured directory with a chain of forty typedefs, where the pattern of each references that of the previous one twice, such that folding them all would double its length forty times. Returns the path of the file. */
+static std::string generate_doubling(const Config& config) {
+    mkdir(config.directory.c_str(), 0755);
+
+    std::string path = config.directory + "/doubling.adl";
+    std::ofstream file(path);
+    for (size_t i = 0; i < 40; i++) {
+        file << "<twice_" << i << "> {" << endl;
+        if (i == 0) { file << "    .pattern r\"[0-9]+\";" << endl; }
+        else { file << "    .pattern <twice_" << i - 1 << ">.pattern \"-\" <twice_" << i - 1 << ">.pattern;" << endl; }
+        file << "}" << endl;
+    }
+
+    return path;
+}
+
+/* Writes a specification to the configured directory that parses fine, but in which each typedef triggers an integer overflow, a float overflow and two stray semicolons. Returns the path of the file. */
+static std::string generate_noisy(const Config& config) {
+    mkdir(config.directory.c_str(), 0755);
+
+    std::string path = config.directory + "/noisy.adl";
+    std::ofstream file(path);
+    std::string huge(320, '9');
+    for (size_t i = 0; i < config.n_definitions; i++) {
+        file << "<noisy_" << i << "> {" << endl;
+        file << "    .big 99999999999999999999;" << endl;
+        file << "    .huge " << huge << ".0;" << endl;
+        file << "    .name \"Noisy " << i << "\";;" << endl;
+        file << "    ;" << endl;
+        file << "}" << endl << endl;
+    }
+
+    return path;
+}
+
+/* Writes a file of a hundred thousand pseudo-random bytes to the configured directory, like a binary file that was passed by mistake. Its size doesn't depend on the number of definitions, so it always holds more errors than the limit of the corrupt phase. Returns the path of the file. */
+static std::string generate_corrupt(const Config& config) {
+    mkdir(config.directory.c_str(), 0755);
+
+    std::string path = config.directory + "/corrupt.adl";
+    std::ofstream file(path, std::ios::binary);
+    uint32_t state = 42;
+    for (size_t i = 0; i < 100000; i++) {
+        // A simple LCG is random enough, as long as it never produces the byte that reads as EOF
+        state = state * 1664525 + 1013904223;
+        char c = (char) (state >> 24);
+        file.put(c == (char) EOF ? ' ' : c);
+    }
+
+    return path;
+}
+
+/* The number of bytes that were allocated when the current measurement started. */
+static size_t n_base_bytes = 0;
+
+/* Starts a measurement by resetting the allocation counters and the peak. Returns the current time. */
+static std::chrono::steady_clock::time_point start_run() {
+    n_allocations = 0;
+    n_allocated_bytes = 0;
+    n_base_bytes = n_live_bytes;
+    n_peak_bytes = n_base_bytes;
+    return std::chrono::steady_clock::now();
+}
+
+/* Stops a measurement, updating the given Measurement if the run was faster than previous ones. */
+static void stop_run(Measurement& measurement, std::chrono::steady_clock::time_point start, size_t items) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocations = n_allocations;
+    size_t allocated_bytes = n_allocated_bytes;
+    size_t peak_bytes = n_peak_bytes - n_base_bytes;
+    if (measurement.seconds < 0 || seconds < measurement.seconds) {
+        measurement.seconds = seconds;
+        measurement.items = items;
+        measurement.allocations = allocations;
+        measurement.allocated_bytes = allocated_bytes;
+        measurement.peak_bytes = peak_bytes;
+    }
+}
+
+/* Writes a measurement as a JSON object, naming the items with the given unit. */
+static void print_measurement(std::ostream& os, const std::string& name, const Measurement& measurement, const std::string& unit, bool last = false) {
+    os << "        \"" << name << "\": {" << endl;
+    os << "            \"seconds\": " << measurement.seconds << "," << endl;
+    if (!unit.empty()) {
+        os << "            \"" << unit << "\": " << measurement.items << "," << endl;
+        os << "            \"" << unit << "_per_second\": " << (measurement.seconds > 0 ? measurement.items / measurement.seconds : 0) << "," << endl;
+    }
+    os << "            \"allocations\": " << measurement.allocations << "," << endl;
+    os << "            \"allocated_bytes\": " << measurement.allocated_bytes << "," << endl;
+    os << "            \"peak_bytes\": " << measurement.peak_bytes << endl;
+    os << "        }" << (last ? "" : ",") << endl;
+}
+
+/* Traversal function that visits every node in the tree without changing it, counting the visits. */
+static ADLNode* count_nodes(const char* trav_id, ADLNode* node, void* vcount) {
+    ++*((size_t*) vcount);
+    return node->traverse_recurse(trav_id, nt_all, count_nodes, vcount);
+}
+
+/* Traversal function that replaces the given target node with a copy of itself, as a variant of a cloned tree would. */
+static ADLNode* replace_target(const char*, ADLNode* node, void* vtarget) {
+    return node == (ADLNode*) vtarget ? node->copy() : node;
+}
+
+/* Visitor that visits every node in the tree without changing it, counting the visits. */
+struct CountVisitor {
+    /* The number of nodes visited so far. */
+    size_t count;
+
+    /* Counts the given node and recurses into its children. */
+    inline ADLNode* operator()(const char* trav_id, ADLNode* node) {
+        ++this->count;
+        visit_children(trav_id, node, nt_all, *this);
+        return node;
+    }
+};
+
+/* Parses the given file with its own handler active, as each compilation in the parallel phase does. */
+static void parse_with_handler(const std::string* path, Exceptions::ExceptionHandler* handler) {
+    Exceptions::ExceptionHandler::Scope scope(handler);
+    delete Parser::parse(*path);
+}
+
+/* Parses the given file, making sure it succeeded. */
+static ADLTree* parse_checked(const std::string& path, ParseStatistics* statistics = nullptr) {
+    ADLTree* tree = Parser::parse(path, statistics);
+    if (tree == nullptr) { throw std::runtime_error("Could not parse generated file '" + path + "'"); }
+    return tree;
+}
+
+
+
+
+
+/***** ENTRY POINT *****/
+int main(int argc, char** argv) {
+    // Read the options from the command line
+    Config config({ 1000, 16, 8, 16, 100, 200000, 5, "bin/bench" });
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0) { config.n_definitions = std::stoul(argv[i + 1]); }
+        else if (strcmp(argv[i], "-d") == 0) { config.include_depth = std::stoul(argv[i + 1]); }
+        else if (strcmp(argv[i], "-s") == 0) { config.snippet_lines = std::stoul(argv[i + 1]); }
+        else if (strcmp(argv[i], "-r") == 0) { config.n_references = std::stoul(argv[i + 1]); }
+        else if (strcmp(argv[i], "-t") == 0) { config.n_traversals = std::stoul(argv[i + 1]); }
+        else if (strcmp(argv[i], "-c") == 0) { config.chain_length = std::stoul(argv[i + 1]); }
+        else if (strcmp(argv[i], "-k") == 0) { config.repetitions = std::stoul(argv[i + 1]); }
+        else if (strcmp(argv[i], "-o") == 0) { config.directory = argv[i + 1]; }
+        else {
+            cerr << "Usage: " << argv[0] << " [-n definitions] [-d include_depth] [-s snippet_lines] [-r references] [-t traversals] [-c chain_length] [-k repetitions] [-o directory]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (config.repetitions == 0) { config.repetitions = 1; }
+
+    try {
+        std::string root = generate(config);
+        std::string chain = generate_chain(config);
+        std::string doubling = generate_doubling(config);
+        std::string noisy = generate_noisy(config);
+        std::string corrupt = generate_corrupt(config);
+        DebugInfo noisy_debug({ noisy }, 2, 10, 2, 29);
+        NullBuffer null_buffer;
+        Measurement tokenizer({ -1, 0, 0, 0, 0 }), preprocessor({ -1, 0, 0, 0, 0 }), parser({ -1, 0, 0, 0, 0 }), build_symbol_table({ -1, 0, 0, 0, 0 }), check_references({ -1, 0, 0, 0, 0 }), semantic_analysis({ -1, 0, 0, 0, 0 }), flatten({ -1, 0, 0, 0, 0 }), flat_semantic_analysis({ -1, 0, 0, 0, 0 }), dependency_graph({ -1, 0, 0, 0, 0 }), dependency_chain({ -1, 0, 0, 0, 0 }), fold_patterns({ -1, 0, 0, 0, 0 }), traversal({ -1, 0, 0, 0, 0 }), visitor({ -1, 0, 0, 0, 0 }), clone({ -1, 0, 0, 0, 0 }), noisy_parse({ -1, 0, 0, 0, 0 }), render_diagnostics({ -1, 0, 0, 0, 0 }), log_warnings({ -1, 0, 0, 0, 0 }), suppressed_warnings({ -1, 0, 0, 0, 0 }), suppressed_spans({ -1, 0, 0, 0, 0 }), parallel_parse({ -1, 0, 0, 0, 0 }), corrupt_parse({ -1, 0, 0, 0, 0 });
+        size_t n_threads = std::max(2U, std::thread::hardware_concurrency());
+        size_t n_shifts = 0;
+
+        // Make sure the specification compiles without errors, so the traversals aren't timing their error paths instead
+        {
+            Exceptions::ExceptionHandler handler(false);
+            Exceptions::ExceptionHandler::Scope scope(&handler);
+            ADLTree* tree = parse_checked(root);
+            traversal_semantic_analysis(tree);
+            DependencyGraph dependencies = traversal_build_dependency_graph(tree);
+            traversal_fold_patterns(tree, dependencies);
+            delete tree;
+            if (handler.errors() > 0) {
+                handler.flush(cerr);
+                throw std::runtime_error("Generated file '" + root + "' does not compile without errors");
+            }
+        }
+
+        for (size_t k = 0; k < config.repetitions; k++) {
+            // The tokenizer, on the root file alone
+            {
+                std::chrono::steady_clock::time_point start = start_run();
+                size_t n_tokens = 0;
+                {
+                    Tokenizer in(new std::ifstream(root), { root });
+                    while (true) {
+                        Token* token = in.pop();
+                        bool done = token->type == TokenType::empty;
+                        delete token;
+                        if (done) { break; }
+                        ++n_tokens;
+                    }
+                }
+                stop_run(tokenizer, start, n_tokens);
+            }
+
+            // The preprocessor, which also tokenizes all included files
+            {
+                std::chrono::steady_clock::time_point start = start_run();
+                size_t n_tokens = 0;
+                {
+                    Preprocessor in(root, {});
+                    while (true) {
+                        Token* token = in.pop();
+                        bool done = token->type == TokenType::empty;
+                        delete token;
+                        if (done) { break; }
+                        ++n_tokens;
+                    }
+                }
+                stop_run(preprocessor, start, n_tokens);
+            }
+
+            // The parser, which includes the preprocessor
+            {
+                ParseStatistics statistics;
+                std::chrono::steady_clock::time_point start = start_run();
+                ADLTree* tree = parse_checked(root, &statistics);
+                stop_run(parser, start, statistics.reductions);
+                n_shifts = statistics.shifts;
+                delete tree;
+            }
+
+            // The first traversal
+            {
+                ADLTree* tree = parse_checked(root);
+                std::chrono::steady_clock::time_point start = start_run();
+                tree->symbol_table = traversal_build_symbol_table(tree);
+                stop_run(build_symbol_table, start, tree->symbol_table.size());
+                delete tree;
+            }
+
+            // The second traversal
+            {
+                ADLTree* tree = parse_checked(root);
+                tree->symbol_table = traversal_build_symbol_table(tree);
+                std::chrono::steady_clock::time_point start = start_run();
+                traversal_check_references(tree);
+                stop_run(check_references, start, 0);
+                delete tree;
+            }
+
+            // Both traversals fused into one
+            {
+                ADLTree* tree = parse_checked(root);
+                std::chrono::steady_clock::time_point start = start_run();
+                traversal_semantic_analysis(tree);
+                stop_run(semantic_analysis, start, tree->symbol_table.size());
+                delete tree;
+            }
+
+            // Flattening the tree, and then the fused traversal on the flat tree
+            {
+                ADLTree* tree = parse_checked(root);
+                std::chrono::steady_clock::time_point start = start_run();
+                ADLFlatTree flat(tree);
+                stop_run(flatten, start, flat.size());
+                start = start_run();
+                traversal_semantic_analysis(tree, flat);
+                stop_run(flat_semantic_analysis, start, tree->symbol_table.size());
+                delete tree;
+            }
+
+            // Building the dependency graph of an analysed tree
+            {
+                ADLTree* tree = parse_checked(root);
+                traversal_semantic_analysis(tree);
+                std::chrono::steady_clock::time_point start = start_run();
+                DependencyGraph dependencies = traversal_build_dependency_graph(tree);
+                stop_run(dependency_graph, start, dependencies.edges());
+                delete tree;
+            }
+
+            // Building the dependency graph of a single chain as long as the file, which should not recurse once per link
+            {
+                Exceptions::ExceptionHandler handler(false);
+                Exceptions::ExceptionHandler::Scope scope(&handler);
+                ADLTree* tree = parse_checked(chain);
+                traversal_semantic_analysis(tree);
+                std::chrono::steady_clock::time_point start = start_run();
+                DependencyGraph dependencies = traversal_build_dependency_graph(tree);
+                stop_run(dependency_chain, start, dependencies.edges());
+                delete tree;
+                if (handler.errors() > 0) { throw std::runtime_error("Dependency chain '" + chain + "' does not analyse without errors"); }
+            }
+
+            // Folding the pattern chains of an analysed tree
+            {
+                ADLTree* tree = parse_checked(root);
+                traversal_semantic_analysis(tree);
+                DependencyGraph dependencies = traversal_build_dependency_graph(tree);
+                std::chrono::steady_clock::time_point start = start_run();
+                size_t n_folded = traversal_fold_patterns(tree, dependencies);
+                stop_run(fold_patterns, start, n_folded);
+                delete tree;
+
+                // Folding a clone of the tree should leave the original as it was, including the references in its symbol tables
+                tree = parse_checked(root);
+                traversal_semantic_analysis(tree);
+                dependencies = traversal_build_dependency_graph(tree);
+                std::stringstream before, after;
+                tree->print(before);
+                tree->symbol_table.print(before);
+                ADLTree* variant = tree->copy();
+                traversal_fold_patterns(variant, dependencies);
+                delete variant;
+                tree->print(after);
+                tree->symbol_table.print(after);
+                delete tree;
+                if (before.str() != after.str()) { throw std::runtime_error("Folding the patterns of a cloned tree changed the original"); }
+
+                // Patterns that double in length with each link should only be folded until they grow too long
+                Exceptions::ExceptionHandler handler(false);
+                Exceptions::ExceptionHandler::Scope scope(&handler);
+                tree = parse_checked(doubling);
+                traversal_semantic_analysis(tree);
+                dependencies = traversal_build_dependency_graph(tree);
+                n_folded = traversal_fold_patterns(tree, dependencies);
+                delete tree;
+                if (handler.errors() > 0 || n_folded == 0 || n_folded >= 39) { throw std::runtime_error("Folding the doubling patterns in '" + doubling + "' did not stop at the maximum length"); }
+            }
+
+            // Bare traversals over the whole tree, to measure the cost of the traversal machinery itself
+            {
+                ADLTree* tree = parse_checked(root);
+                size_t n_visits = 0;
+                std::chrono::steady_clock::time_point start = start_run();
+                for (size_t t = 0; t < config.n_traversals; t++) {
+                    tree->traverse("bench_traversal", nt_all, count_nodes, (void*) &n_visits);
+                }
+                stop_run(traversal, start, n_visits);
+                delete tree;
+            }
+
+            // The same, but with the templated visitor
+            {
+                ADLTree* tree = parse_checked(root);
+                CountVisitor counter({ 0 });
+                std::chrono::steady_clock::time_point start = start_run();
+                for (size_t t = 0; t < config.n_traversals; t++) {
+                    visit("bench_visitor", tree, nt_all, counter);
+                }
+                stop_run(visitor, start, counter.count);
+                delete tree;
+            }
+
+            // Cloning the tree and replacing the identifier of its last definition in the clone, which only copies the path up to it
+            {
+                ADLTree* tree = parse_checked(root);
+                ADLDefinition* last = (ADLDefinition*) tree->children.back();
+                ADLNode* target = last->identifier != nullptr ? last->identifier : last->longlabel != nullptr ? last->longlabel : last->shortlabel;
+                std::chrono::steady_clock::time_point start = start_run();
+                for (size_t t = 0; t < config.n_traversals; t++) {
+                    ADLTree* variant = tree->copy();
+                    variant->traverse("bench_clone", NodeType::identifier, replace_target, (void*) target);
+                    delete variant;
+                }
+                stop_run(clone, start, config.n_traversals);
+
+                // The variant should still be whole once the original is gone, including the pointers to the replaced node
+                ADLTree* variant = tree->copy();
+                variant->traverse("bench_clone", NodeType::identifier, replace_target, (void*) target);
+                delete tree;
+                ADLDefinition* copied = (ADLDefinition*) variant->children.back();
+                ADLNode* label = copied->identifier != nullptr ? copied->identifier : copied->longlabel != nullptr ? copied->longlabel : copied->shortlabel;
+                if (label == target || std::find(copied->children.begin(), copied->children.end(), label) == copied->children.end()) { throw std::runtime_error("Cloned definition does not point to its own replaced identifier"); }
+                std::stringstream sstr;
+                copied->print(sstr);
+                delete variant;
+            }
+
+            // Parsing a file that triggers four warnings per definition, with the printed diagnostics thrown away
+            {
+                std::streambuf* cerr_buffer = cerr.rdbuf(&null_buffer);
+                std::chrono::steady_clock::time_point start = start_run();
+                ADLTree* tree = parse_checked(noisy);
+                stop_run(noisy_parse, start, 4 * config.n_definitions);
+                cerr.rdbuf(cerr_buffer);
+                delete tree;
+            }
+
+            // Rendering the diagnostics of the noisy file as text, which cuts the snippet of each line they point to from its source only once
+            {
+                Exceptions::ExceptionHandler handler(false);
+                handler.colour = false;
+                parse_with_handler(&noisy, &handler);
+                std::chrono::steady_clock::time_point start = start_run();
+                std::string rendered = handler.render(0, handler.size());
+                stop_run(render_diagnostics, start, handler.size());
+                if (rendered.find(" | ") == std::string::npos) { throw std::runtime_error("Rendered diagnostics have no source snippets"); }
+            }
+
+            // Logging warnings in a handler directly, to measure the cost of the handler itself
+            {
+                Exceptions::ExceptionHandler handler(false);
+                size_t n_warnings = config.n_definitions * config.n_traversals;
+                std::chrono::steady_clock::time_point start = start_run();
+                for (size_t w = 0; w < n_warnings; w++) {
+                    handler.log(Exceptions::OverflowWarning(noisy_debug));
+                }
+                stop_run(log_warnings, start, handler.warnings());
+            }
+
+            // The same, but with the warnings suppressed
+            {
+                Exceptions::ExceptionHandler handler(false);
+                handler.suppressed_types = Exceptions::WarningType::int_overflow;
+                size_t n_warnings = config.n_definitions * config.n_traversals;
+                std::chrono::steady_clock::time_point start = start_run();
+                for (size_t w = 0; w < n_warnings; w++) {
+                    handler.warn<Exceptions::OverflowWarning>(noisy_debug);
+                }
+                stop_run(suppressed_warnings, start, n_warnings);
+            }
+
+            // The same, but with the warnings suppressed by @suppress-like spans, so that each has to be looked up by where it points to
+            {
+                Exceptions::ExceptionHandler handler(false);
+                Exceptions::SuppressionList suppressions;
+                for (size_t d = 0; d < config.n_definitions; d++) {
+                    suppressions.suppress(Exceptions::SuppressionScope::toplevel, DebugInfo({ noisy }, 4 * d + 1, 1), Exceptions::WarningType::int_overflow);
+                    suppressions.close(Exceptions::SuppressionScope::toplevel, DebugInfo({ noisy }, 4 * d + 2, 80));
+                }
+                Exceptions::SuppressionList::Scope suppression_scope(&suppressions);
+                size_t n_warnings = config.n_definitions * config.n_traversals;
+                DebugInfo debug({ noisy }, 1, 10);
+                std::chrono::steady_clock::time_point start = start_run();
+                for (size_t w = 0; w < n_warnings; w++) {
+                    // Only move the position, so the phase doesn't measure building a new list of filenames each time
+                    debug.line1 = w % (4 * config.n_definitions) + 1;
+                    debug.line2 = debug.line1;
+                    handler.log(Exceptions::OverflowWarning(debug));
+                }
+                stop_run(suppressed_spans, start, n_warnings);
+            }
+
+            // Parsing the noisy file on several threads at once, each as a task of a diagnostic sink, and merging their diagnostics in task order afterwards
+            {
+                Exceptions::ExceptionHandler merged(false);
+                Exceptions::DiagnosticSink sink(merged);
+                sink.begin(n_threads);
+                std::vector<std::thread> threads;
+                std::chrono::steady_clock::time_point start = start_run();
+                for (size_t t = 0; t < n_threads; t++) {
+                    threads.push_back(std::thread(parse_with_handler, &noisy, &sink[t]));
+                }
+                for (size_t t = 0; t < n_threads; t++) {
+                    threads[t].join();
+                }
+                sink.end();
+                stop_run(parallel_parse, start, merged.size());
+
+                // Running the same tasks one after the other should give the exact same diagnostics
+                Exceptions::ExceptionHandler serial(false);
+                Exceptions::DiagnosticSink serial_sink(serial);
+                serial_sink.begin(n_threads);
+                for (size_t t = 0; t < n_threads; t++) {
+                    parse_with_handler(&noisy, &serial_sink[t]);
+                }
+                serial_sink.end();
+                if (merged.size() != serial.size() || merged.render(0, merged.size()) != serial.render(0, serial.size())) { throw std::runtime_error("Parallel compilations logged different diagnostics than serial ones"); }
+            }
+
+            // Parsing a file of random bytes with a limit on the number of errors, which should give up long before it reaches the end
+            {
+                Exceptions::ExceptionHandler handler(false);
+                handler.max_errors = 100;
+                Exceptions::ExceptionHandler::Scope scope(&handler);
+                std::chrono::steady_clock::time_point start = start_run();
+                ADLTree* tree = Parser::parse(corrupt);
+                stop_run(corrupt_parse, start, handler.errors());
+                if (tree != nullptr || !handler.exhausted()) { throw std::runtime_error("Parsing a corrupt file did not stop at the error limit"); }
+            }
+        }
+
+        // Write the results
+        cout << "{" << endl;
+        cout << "    \"config\": {" << endl;
+        cout << "        \"definitions\": " << config.n_definitions << "," << endl;
+        cout << "        \"include_depth\": " << config.include_depth << "," << endl;
+        cout << "        \"snippet_lines\": " << config.snippet_lines << "," << endl;
+        cout << "        \"references\": " << config.n_references << "," << endl;
+        cout << "        \"traversals\": " << config.n_traversals << "," << endl;
+        cout << "        \"chain_length\": " << config.chain_length << "," << endl;
+        cout << "        \"repetitions\": " << config.repetitions << "," << endl;
+        cout << "        \"threads\": " << n_threads << "," << endl;
+        cout << "        \"shifts\": " << n_shifts << endl;
+        cout << "    }," << endl;
+        cout << "    \"phases\": {" << endl;
+        print_measurement(cout, "tokenizer", tokenizer, "tokens");
+        print_measurement(cout, "preprocessor", preprocessor, "tokens");
+        print_measurement(cout, "parser", parser, "reductions");
+        print_measurement(cout, "build_symbol_table", build_symbol_table, "symbols");
+        print_measurement(cout, "check_references", check_references, "");
+        print_measurement(cout, "semantic_analysis", semantic_analysis, "symbols");
+        print_measurement(cout, "flatten", flatten, "nodes");
+        print_measurement(cout, "flat_semantic_analysis", flat_semantic_analysis, "symbols");
+        print_measurement(cout, "dependency_graph", dependency_graph, "edges");
+        print_measurement(cout, "dependency_chain", dependency_chain, "edges");
+        print_measurement(cout, "fold_patterns", fold_patterns, "patterns");
+        print_measurement(cout, "traversal", traversal, "visits");
+        print_measurement(cout, "visitor", visitor, "visits");
+        print_measurement(cout, "clone", clone, "clones");
+        print_measurement(cout, "noisy_parse", noisy_parse, "warnings");
+        print_measurement(cout, "render_diagnostics", render_diagnostics, "diagnostics");
+        print_measurement(cout, "log_warnings", log_warnings, "warnings");
+        print_measurement(cout, "suppressed_warnings", suppressed_warnings, "warnings");
+        print_measurement(cout, "suppressed_spans", suppressed_spans, "warnings");
+        print_measurement(cout, "parallel_parse", parallel_parse, "warnings");
+        print_measurement(cout, "corrupt_parse", corrupt_parse, "errors", true);
+        cout << "    }" << endl;
+        cout << "}" << endl;
+
+        return EXIT_SUCCESS;
+    } catch (Exceptions::ExceptionHandler& e) {
+        return EXIT_FAILURE;
+    } catch (std::exception& e) {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,331 @@
+/* FUZZ ADL.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 17:19:33
+ * Last edited:
+ *   18/10/2026, 17:27:39
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   Fuzzing entry points for the Tokenizer, the Preprocessor and the
+ *   Parser, of which one is chosen by defining FUZZ_TOKENIZER,
+ *   FUZZ_PREPROCESSOR or FUZZ_PARSER. Each input is compiled in memory
+ *   with a handler of its own, and is timed and its memory counted while
+ *   it runs. Inputs that take longer or use more memory than a budget
+ *   that grows linearly with their size abort, so super-linear behaviour
+ *   is caught just like a crash. Built with libFuzzer, these are regular
+ *   fuzz targets. Built with FUZZ_STANDALONE, a driver of their own runs
+ *   each given input (or each file in a given directory) once as-is and
+ *   once twice in a row, and reports the time, the memory and how much
+ *   they grew with the input as JSON.
+**/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <dirent.h>
+#include <malloc.h>
+#include <sys/stat.h>
+
+#include "SourceManager.hpp"
+#include "ADLTokenizer.hpp"
+#include "ADLPreprocessor.hpp"
+#include "ADLParser.hpp"
+
+#if !defined(FUZZ_TOKENIZER) && !defined(FUZZ_PREPROCESSOR) && !defined(FUZZ_PARSER)
+#error "Define one of FUZZ_TOKENIZER, FUZZ_PREPROCESSOR or FUZZ_PARSER to choose what to fuzz"
+#endif
+
+/* The time every input may take regardless of its size, in milliseconds. */
+#ifndef FUZZ_BASE_MS
+#define FUZZ_BASE_MS 250
+#endif
+/* The time every input may take per byte on top of that, in microseconds. */
+#ifndef FUZZ_US_PER_BYTE
+#define FUZZ_US_PER_BYTE 50
+#endif
+/* The memory every input may use regardless of its size, in megabytes. */
+#ifndef FUZZ_BASE_MB
+#define FUZZ_BASE_MB 64
+#endif
+/* The memory every input may use per byte on top of that, in bytes. */
+#ifndef FUZZ_BYTES_PER_BYTE
+#define FUZZ_BYTES_PER_BYTE 4096
+#endif
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** MEMORY ACCOUNTING *****/
+/* The number of allocations done so far. Atomic, since the fuzzing engine may allocate from threads of its own. */
+static std::atomic<size_t> n_allocations(0);
+/* The number of bytes currently allocated. */
+static std::atomic<size_t> n_live_bytes(0);
+/* The highest number of bytes allocated at once since the last reset. */
+static std::atomic<size_t> n_peak_bytes(0);
+
+/* Global override of the new operator that keeps track of the memory in use. */
+void* operator new(size_t size) {
+    void* result = malloc(size == 0 ? 1 : size);
+    if (result == nullptr) { throw std::bad_alloc(); }
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    // Raise the peak if we went over it
+    size_t usable = malloc_usable_size(result);
+    size_t live = n_live_bytes.fetch_add(usable, std::memory_order_relaxed) + usable;
+    size_t peak = n_peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !n_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    return result;
+}
+/* Global override of the new[] operator that keeps track of the memory in use. */
+void* operator new[](size_t size) { return operator new(size); }
+/* Global override of the delete operator to match the new operator. */
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) { return; }
+    n_live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    free(ptr);
+}
+/* Global override of the delete[] operator to match the new[] operator. */
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+/* Global override of the sized delete operator to match the new operator. */
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+/* Global override of the sized delete[] operator to match the new[] operator. */
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+
+
+
+
+/***** HELPER STRUCTS *****/
+/* The in-memory files of a single input, by their path. */
+struct MemoryFiles {
+    /* The contents of each file. */
+    std::unordered_map<std::string, std::string> files;
+};
+
+/* Measurements for a single run of an input. */
+struct Measurement {
+    /* The time the run took, in seconds. */
+    double seconds;
+    /* The number of allocations done during the run. */
+    size_t allocations;
+    /* The highest number of bytes allocated at once during the run, on top of what was allocated before it. */
+    size_t peak_bytes;
+};
+
+
+
+
+
+/***** CONSTANTS *****/
+/* The path of the root file of each input. */
+static const char* root_path = "fuzz/root.adl";
+/* Lines starting with this marker start a new in-memory file, at the path that follows it on the line. Since the marker is a comment, the input as a whole is still valid ADL. */
+static const char* file_marker = "//@file ";
+
+
+
+
+
+/***** HELPER FUNCTIONS *****/
+/* Splits the given input into in-memory files. Everything up to the first file marker is the root file. */
+static void split_files(const uint8_t* data, size_t size, MemoryFiles& result) {
+    size_t marker_length = strlen(file_marker);
+    std::string* current = &result.files[root_path];
+    size_t i = 0;
+    while (i < size) {
+        // Find the end of the line (including its newline)
+        const uint8_t* newline = (const uint8_t*) memchr(data + i, '\n', size - i);
+        size_t end = newline != nullptr ? (size_t) (newline - data) + 1 : size;
+
+        // Either start a new file or add the line to the current one
+        if (end - i >= marker_length && memcmp(data + i, file_marker, marker_length) == 0) {
+            size_t path_end = newline != nullptr ? end - 1 : end;
+            current = &result.files[std::string((const char*) data + i + marker_length, path_end - i - marker_length)];
+            current->clear();
+        } else {
+            current->append((const char*) data + i, end - i);
+        }
+        i = end;
+    }
+}
+
+/* Opens the in-memory file at the given path, or returns a stream that isn't open if there is no such file. */
+static std::istream* open_memory(const std::string& path, void* vfiles) {
+    MemoryFiles* files = (MemoryFiles*) vfiles;
+    std::unordered_map<std::string, std::string>::const_iterator iter = files->files.find(path);
+    if (iter == files->files.end()) { return new std::ifstream(); }
+    return new std::istringstream(iter->second);
+}
+
+/* Runs the stage that is fuzzed on the given input, with a handler of its own. */
+static void run(const uint8_t* data, size_t size) {
+    Exceptions::ExceptionHandler handler(false);
+    handler.max_errors = 100;
+    Exceptions::ExceptionHandler::Scope scope(&handler);
+    try {
+        #if defined(FUZZ_TOKENIZER)
+        Tokenizer in(new std::istringstream(std::string((const char*) data, size)), { root_path });
+        while (!in.eof()) { delete in.pop(); }
+        #elif defined(FUZZ_PREPROCESSOR)
+        MemoryFiles files;
+        split_files(data, size, files);
+        Preprocessor in(root_path, {}, open_memory, (void*) &files);
+        while (!in.eof()) { delete in.pop(); }
+        #else
+        MemoryFiles files;
+        split_files(data, size, files);
+        delete Parser::parse(root_path, open_memory, (void*) &files);
+        #endif
+    } catch (Exceptions::ExceptionHandler&) {
+        // Stopping at an error is fine; only crashes and runaway inputs aren't
+    }
+
+    // Forget the input's files, so the source manager doesn't grow with every path the fuzzer comes up with
+    source_manager.clear();
+}
+
+/* Runs the given input once and measures how long it took and how much memory it used. */
+static Measurement measure(const uint8_t* data, size_t size) {
+    size_t start_allocations = n_allocations.load();
+    size_t start_bytes = n_live_bytes.load();
+    n_peak_bytes.store(start_bytes);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    run(data, size);
+
+    Measurement result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.allocations = n_allocations.load() - start_allocations;
+    result.peak_bytes = n_peak_bytes.load() - start_bytes;
+    return result;
+}
+
+/* Returns whether the given measurement of an input of the given size stayed within the budget for its size. */
+static bool within_budget(size_t size, const Measurement& measurement) {
+    double max_seconds = FUZZ_BASE_MS / 1e3 + FUZZ_US_PER_BYTE / 1e6 * size;
+    size_t max_bytes = (size_t) FUZZ_BASE_MB * 1024 * 1024 + (size_t) FUZZ_BYTES_PER_BYTE * size;
+    return measurement.seconds <= max_seconds && measurement.peak_bytes <= max_bytes;
+}
+
+/* Writes the given measurement of an input of the given size to the given stream, as the fields of a JSON object. */
+static void print_measurement(std::ostream& os, const char* prefix, size_t size, const Measurement& measurement) {
+    os << "\"" << prefix << "bytes\":" << size << ",\"" << prefix << "seconds\":" << measurement.seconds << ",\"" << prefix << "allocations\":" << measurement.allocations << ",\"" << prefix << "peak_bytes\":" << measurement.peak_bytes;
+}
+
+
+
+
+
+/***** ENTRY POINT *****/
+/* Entry point for the fuzzing engine, which runs a single input. Aborts if the input went over its budget, so the engine keeps it like it does crashing inputs. */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    Measurement measurement = measure(data, size);
+    if (!within_budget(size, measurement)) {
+        std::cerr << "{";
+        print_measurement(std::cerr, "", size, measurement);
+        std::cerr << ",\"error\":\"over budget\"}" << std::endl;
+        abort();
+    }
+    return 0;
+}
+
+
+
+#ifdef FUZZ_STANDALONE
+/* The number of times each input is run by the standalone driver; the fastest run is reported. */
+#define FUZZ_REPETITIONS 3
+/* The factor by which the time of an input may grow when it's doubled before the standalone driver calls it super-linear. */
+#define FUZZ_MAX_GROWTH 3.0
+/* The time below which the standalone driver doesn't look at growth, since it's mostly noise. */
+#define FUZZ_MIN_GROWTH_SECONDS 0.01
+
+/* Adds the given path to the given list of inputs if it's a file, or all files in it (in order) if it's a directory. */
+static void collect_inputs(const std::string& path, std::vector<std::string>& inputs) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) { return; }
+    if (!S_ISDIR(info.st_mode)) {
+        inputs.push_back(path);
+        return;
+    }
+
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) { return; }
+    std::vector<std::string> entries;
+    for (struct dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') { continue; }
+        entries.push_back(path + "/" + entry->d_name);
+    }
+    closedir(dir);
+    std::sort(entries.begin(), entries.end());
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (stat(entries[i].c_str(), &info) == 0 && !S_ISDIR(info.st_mode)) { inputs.push_back(entries[i]); }
+    }
+}
+
+/* Runs the given input a few times and returns the fastest run. */
+static Measurement measure_fastest(const std::string& input) {
+    Measurement result = measure((const uint8_t*) input.data(), input.size());
+    for (size_t i = 1; i < FUZZ_REPETITIONS; i++) {
+        Measurement run = measure((const uint8_t*) input.data(), input.size());
+        if (run.seconds < result.seconds) { result = run; }
+    }
+    return result;
+}
+
+/* Entry point for the standalone driver, which runs each input given on the command line and writes one JSON object per input to stdout. Returns a nonzero exit code if any of them went over its budget or grew super-linearly. */
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') { continue; }
+        collect_inputs(argv[i], inputs);
+    }
+    if (inputs.empty()) {
+        std::cout << "Usage: " << argv[0] << " <input file or directory>..." << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        // Read the input
+        std::ifstream file(inputs[i], std::ios::binary);
+        std::stringstream sstr;
+        sstr << file.rdbuf();
+        std::string input = sstr.str();
+
+        // Run it as-is and twice in a row, to see how it grows
+        Measurement single = measure_fastest(input);
+        Measurement doubled = measure_fastest(input + input);
+        double growth = single.seconds > 0 ? doubled.seconds / single.seconds : 0;
+        bool superlinear = doubled.seconds >= FUZZ_MIN_GROWTH_SECONDS && growth > FUZZ_MAX_GROWTH;
+        bool input_ok = within_budget(input.size(), single) && within_budget(2 * input.size(), doubled) && !superlinear;
+        ok = ok && input_ok;
+
+        // Report it
+        std::cout << "{\"input\":\"";
+        for (size_t j = 0; j < inputs[i].size(); j++) {
+            if (inputs[i][j] == '"' || inputs[i][j] == '\\') { std::cout << '\\'; }
+            std::cout << inputs[i][j];
+        }
+        std::cout << "\",";
+        print_measurement(std::cout, "", input.size(), single);
+        std::cout << ",";
+        print_measurement(std::cout, "doubled_", 2 * input.size(), doubled);
+        std::cout << ",\"growth\":" << growth << ",\"ok\":" << (input_ok ? "true" : "false") << "}" << std::endl;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+#endif
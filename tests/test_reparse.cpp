@@ -0,0 +1,186 @@
+/* TEST REPARSE.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 19:28:06
+ * Last edited:
+ *   18/10/2026, 19:33:02
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   In this file, we test re-parsing a single changed definition. Each
+ *   case writes a small specification, parses & analyses it, changes the
+ *   file and then patches the tree with reparse_definition(). Changes it
+ *   should handle have to give the same tree as parsing the changed file
+ *   from scratch; changes it shouldn't have to leave the tree untouched.
+**/
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#include "ADLParser.hpp"
+#include "ADLExceptions.hpp"
+#include "ADLDefinition.hpp"
+#include "SemanticAnalysis.hpp"
+#include "ReparseDefinition.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** HELPER STRUCTS *****/
+/* A single test case, which replaces the first occurrence of a piece of the specification by another. */
+struct Case {
+    /* The name of the case. */
+    std::string name;
+    /* The piece of the specification to replace. */
+    std::string from;
+    /* The piece to replace it with. */
+    std::string to;
+    /* Whether reparse_definition() should be able to handle the change. */
+    bool handled;
+};
+
+
+
+
+
+/***** HELPER FUNCTIONS *****/
+/* The specification each case starts from. */
+static const char* specification =
+    "<num> {\n"
+    "    .pattern r\"[0-9]+\";\n"
+    "}\n"
+    "\n"
+    "pos_a <num> {\n"
+    "    .description \"First\";\n"
+    "}\n"
+    "\n"
+    "meta {\n"
+    "    .auto_help (false);\n"
+    "}\n"
+    "\n"
+    "pos_b <num> {\n"
+    "    .description \"Second\";\n"
+    "}\n"
+    "\n"
+    "pos_c <num> {\n"
+    "    .description \"Last\";\n"
+    "}\n";
+
+/* Writes the given contents to the file at the given path. */
+static void write(const std::string& path, const std::string& contents) {
+    std::ofstream file(path);
+    file << contents;
+}
+
+/* Parses & analyses the file at the given path. Returns a nullptr if that failed. */
+static ADLTree* analyse(const std::string& path) {
+    ADLTree* tree = Parser::parse(path);
+    if (tree != nullptr) { traversal_semantic_analysis(tree); }
+    return tree;
+}
+
+/* Writes the given symbol table (and those nested in it) to the given output stream, sorted by id and with the references of each entry sorted by where they are, since a patched table may list them in another order than a fresh one. */
+static void dump_table(std::ostream& os, const SymbolTable& symbol_table, const std::string& indent) {
+    std::vector<std::string> entries;
+    for (const SymbolTableEntry& entry : symbol_table) {
+        std::stringstream sstr;
+        sstr << indent << entry.id << endl;
+
+        // Write the references in order of where they are
+        std::vector<std::string> references;
+        for (size_t i = 0; i < entry.references.size(); i++) {
+            const DebugInfo& debug = entry.references[i]->debug;
+            references.push_back(indent + "    referenced at " + std::to_string(debug.line1) + ":" + std::to_string(debug.col1) + "\n");
+        }
+        std::sort(references.begin(), references.end());
+        for (size_t i = 0; i < references.size(); i++) { sstr << references[i]; }
+
+        // Then the properties of definitions
+        if (entry.node_type & nt_toplevel) { dump_table(sstr, ((ADLDefinition*) entry.node)->symbol_table, indent + "    "); }
+        entries.push_back(sstr.str());
+    }
+    std::sort(entries.begin(), entries.end());
+    for (size_t i = 0; i < entries.size(); i++) { os << entries[i]; }
+}
+
+/* Writes the given tree and its symbol tables to a string. */
+static std::string dump(ADLTree* tree) {
+    std::stringstream sstr;
+    tree->print(sstr);
+    dump_table(sstr, tree->symbol_table, "");
+    return sstr.str();
+}
+
+/* Runs the given case on a file at the given path. Returns whether it passed. */
+static bool run(const std::string& path, const Case& test) {
+    // Parse the original specification
+    write(path, specification);
+    ADLTree* tree = analyse(path);
+    if (tree == nullptr) { cout << test.name << ": could not parse the original specification" << endl; return false; }
+    std::string before = dump(tree);
+
+    // Change the file, and let the tree know where
+    std::string contents(specification);
+    size_t offset = contents.find(test.from);
+    contents.replace(offset, test.from.size(), test.to);
+    write(path, contents);
+    bool handled = reparse_definition(tree, offset, test.to.size());
+    std::string after = dump(tree);
+    delete tree;
+
+    // Compare it with what we should have gotten
+    bool passed;
+    if (handled != test.handled) {
+        cout << test.name << ": change was " << (handled ? "" : "not ") << "handled incrementally" << endl;
+        passed = false;
+    } else if (handled) {
+        ADLTree* expected = analyse(path);
+        passed = expected != nullptr && dump(expected) == after;
+        delete expected;
+        if (!passed) { cout << test.name << ": patched tree differs from a fresh parse" << endl; }
+    } else {
+        passed = before == after;
+        if (!passed) { cout << test.name << ": tree changed although the change wasn't handled" << endl; }
+    }
+    if (passed) { cout << test.name << ": OK" << endl; }
+    return passed;
+}
+
+
+
+
+
+/***** ENTRY POINT *****/
+int main(int argc, char** argv) {
+    std::string directory = argc >= 2 ? argv[1] : "bin/reparse";
+    mkdir(directory.c_str(), 0755);
+    std::string path = directory + "/reparse.adl";
+
+    Case cases[] = {
+        { "body edit", "\"First\"", "\"The first positional\"", true },
+        { "rename", "pos_b", "pos_bee", true },
+        { "multiline edit", "\"Second\";", "\"Second\";\n    .category \"Positionals\";", true },
+        { "edit spanning two definitions", "\"First\";\n}\n\nmeta {\n    .auto_help (false);\n}\n\npos_b <num> {\n    .description \"Second\"", "\"First and second\"", false },
+        { "removed closing bracket", "\"Second\";\n}", "\"Second\";\n", false },
+        { "meta edit", "(false)", "(true)", false },
+    };
+
+    // Run them all, even if one fails
+    try {
+        bool passed = true;
+        for (size_t i = 0; i < sizeof(cases) / sizeof(Case); i++) {
+            passed = run(path, cases[i]) && passed;
+        }
+        return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (Exceptions::ExceptionHandler& e) {
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,232 @@
+/* TEST STREAM.cpp
+ *   by Lut99
+ *
+ * Created:
+ *   18/10/2026, 19:44:31
+ * Last edited:
+ *   18/10/2026, 19:46:14
+ * Auto updated?
+ *   Yes
+ *
+ * Description:
+ *   In this file, we test parsing a file in a streaming fashion. It
+ *   checks that the callback is called once for every toplevel
+ *   definition, that the definitions it releases are left out of the
+ *   tree (unless they are types, metas or referenced by an earlier
+ *   definition), and that releasing them keeps the memory in use bounded
+ *   by a small multiple of the size of the file, no matter how many
+ *   definitions it has.
+**/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <new>
+#include <malloc.h>
+#include <sys/stat.h>
+
+#include "ADLParser.hpp"
+#include "ADLExceptions.hpp"
+#include "ADLDefinition.hpp"
+#include "ADLIdentifier.hpp"
+
+using namespace std;
+using namespace ArgumentParser;
+
+
+/***** ALLOCATION COUNTING *****/
+/* The number of bytes currently allocated. */
+static size_t n_live_bytes = 0;
+/* The highest number of bytes allocated at once since the last reset. */
+static size_t n_peak_bytes = 0;
+
+/* Global override of the new operator that keeps track of the memory in use. */
+void* operator new(size_t size) {
+    void* result = malloc(size == 0 ? 1 : size);
+    if (result == nullptr) { throw std::bad_alloc(); }
+    n_live_bytes += malloc_usable_size(result);
+    if (n_live_bytes > n_peak_bytes) { n_peak_bytes = n_live_bytes; }
+    return result;
+}
+/* Global override of the new[] operator to match the new operator. */
+void* operator new[](size_t size) { return operator new(size); }
+/* Global override of the delete operator to match the new operator. */
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) { return; }
+    n_live_bytes -= malloc_usable_size(ptr);
+    free(ptr);
+}
+/* Global override of the delete[] operator to match the new[] operator. */
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+/* Global override of the sized delete operator to match the new operator. */
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+/* Global override of the sized delete[] operator to match the new[] operator. */
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+
+
+
+
+/***** HELPER STRUCTS *****/
+/* How many times the size of the file a streaming parse may use at most. Besides the file itself, the source manager keeps where each of its lines start and every identifier stays interned, but no released definition is kept. */
+static const size_t stream_factor = 3;
+
+/* The state passed to the callback. */
+struct StreamState {
+    /* Whether the callback lets the parser release the definitions. */
+    bool release;
+    /* The number of times the callback has been called. */
+    size_t n_calls;
+};
+
+/* The memory used by a single parse, in bytes over what was in use before it. */
+struct Usage {
+    /* The most memory in use at once while parsing. */
+    size_t peak;
+    /* The memory still in use once the returned tree has been deleted. */
+    size_t left;
+};
+
+
+
+
+
+/***** HELPER FUNCTIONS *****/
+/* Writes a specification with a meta, a type, an option that references the first positional and then the given number of positionals and options to the file at the given path. Returns the number of bytes written. */
+static size_t generate(const std::string& path, size_t n_definitions) {
+    std::ofstream file(path);
+    file << "meta {" << endl << "    .auto_help (false);" << endl << "}" << endl << endl;
+    file << "<num> {" << endl << "    .pattern r\"[0-9]+\";" << endl << "}" << endl << endl;
+    file << "--first <num> {" << endl << "    .description pos_0.description;" << endl << "}" << endl << endl;
+    for (size_t i = 0; i < n_definitions; i++) {
+        file << "pos_" << i << " <num> {" << endl;
+        file << "    .category \"Positionals\";" << endl;
+        file << "    .description \"Positional number " << i << ", generated for testing.\";" << endl;
+        file << "}" << endl << endl;
+        file << "--option_" << i << " <num> <num> {" << endl;
+        file << "    .category \"Options\";" << endl;
+        file << "    .description \"Option number " << i << "\";" << endl;
+        file << "}" << endl << endl;
+    }
+    return (size_t) file.tellp();
+}
+
+/* Counts the definitions handed to it, and lets the parser release them if the given state says so. */
+static bool count_definitions(ADLDefinition* definition, void* vstate) {
+    StreamState* state = (StreamState*) vstate;
+    if (definition != nullptr) { ++state->n_calls; }
+    return state->release;
+}
+
+/* Returns the identifier of the given definition, or its type if it hasn't got one. */
+static std::string name(const ADLDefinition* definition) {
+    if (definition->identifier != nullptr) { return definition->identifier->identifier; }
+    if (definition->longlabel != nullptr) { return "--" + definition->longlabel->identifier; }
+    return nodetype_name.at(definition->type);
+}
+
+/* Parses the file at the given path, streaming if the state isn't a nullptr, and returns how much memory that took. */
+static Usage measure(const std::string& path, StreamState* state) {
+    size_t base = n_live_bytes;
+    n_peak_bytes = base;
+    ADLTree* tree = state != nullptr ? Parser::parse(path, count_definitions, (void*) state) : Parser::parse(path);
+    Usage result = { n_peak_bytes - base, 0 };
+    delete tree;
+    result.left = n_live_bytes > base ? n_live_bytes - base : 0;
+    return result;
+}
+
+
+
+
+
+/***** TESTS *****/
+/* Checks that the callback is called once for each toplevel definition, and that a callback that keeps them all gives the same tree as a normal parse. */
+static bool test_keep(const std::string& path, size_t n_definitions) {
+    generate(path, n_definitions);
+    StreamState state = { false, 0 };
+    ADLTree* streamed = Parser::parse(path, count_definitions, (void*) &state);
+    ADLTree* expected = Parser::parse(path);
+    if (streamed == nullptr || expected == nullptr) { cout << "keep: could not parse the specification" << endl; delete streamed; delete expected; return false; }
+
+    // Compare the trees as they would be printed
+    std::stringstream sstr1, sstr2;
+    streamed->print(sstr1);
+    expected->print(sstr2);
+    bool passed = true;
+    if (state.n_calls != 3 + 2 * n_definitions) { cout << "keep: callback was called " << state.n_calls << " times instead of " << 3 + 2 * n_definitions << endl; passed = false; }
+    if (streamed->children.size() != expected->children.size() || sstr1.str() != sstr2.str()) { cout << "keep: streamed tree differs from a normal parse" << endl; passed = false; }
+    delete streamed;
+    delete expected;
+
+    if (passed) { cout << "keep: OK" << endl; }
+    return passed;
+}
+
+/* Checks that a callback that releases everything leaves only the types, metas and definitions referenced by earlier ones in the tree. */
+static bool test_release(const std::string& path, size_t n_definitions) {
+    generate(path, n_definitions);
+    StreamState state = { true, 0 };
+    ADLTree* tree = Parser::parse(path, count_definitions, (void*) &state);
+    if (tree == nullptr) { cout << "release: could not parse the specification" << endl; return false; }
+
+    // Only the meta, the type and the first positional (which the first option references) should be left
+    std::string kept;
+    for (size_t i = 0; i < tree->children.size(); i++) {
+        if (i > 0) { kept += ", "; }
+        kept += name((ADLDefinition*) tree->children[i]);
+    }
+    delete tree;
+    bool passed = true;
+    if (state.n_calls != 3 + 2 * n_definitions) { cout << "release: callback was called " << state.n_calls << " times instead of " << 3 + 2 * n_definitions << endl; passed = false; }
+    if (kept != "meta, <num>, pos_0") { cout << "release: kept " << kept << " instead of meta, <num>, pos_0" << endl; passed = false; }
+
+    if (passed) { cout << "release: OK" << endl; }
+    return passed;
+}
+
+/* Checks that releasing the definitions keeps the memory in use bounded by a small multiple of the size of the file, on a file that is small and on ones that are many times larger. Also checks that every parse gives back all the memory it used once its tree is gone. */
+static bool test_memory(const std::string& path, size_t n_definitions) {
+    // Warm up once, so the source manager knows the path already and later parses start from the same state
+    generate(path, n_definitions);
+    StreamState state = { true, 0 };
+    measure(path, &state);
+
+    bool passed = true;
+    for (size_t scale = 1; scale <= 16; scale *= 4) {
+        size_t n_bytes = generate(path, scale * n_definitions);
+        Usage full = measure(path, nullptr);
+        Usage streamed = measure(path, &state);
+        cout << "memory: " << scale * n_definitions << " definitions (" << n_bytes << " bytes): peak of " << full.peak << " bytes when kept and " << streamed.peak << " bytes when released" << endl;
+
+        // The file itself is read into memory, but the definitions in it shouldn't be
+        if (streamed.peak > stream_factor * n_bytes) { cout << "memory: releasing definitions used more than " << stream_factor << " times the size of the file" << endl; passed = false; }
+        if (streamed.peak * stream_factor > full.peak) { cout << "memory: releasing definitions didn't use much less memory than keeping them" << endl; passed = false; }
+        if (full.left > 0 || streamed.left > 0) { cout << "memory: " << (full.left > streamed.left ? full.left : streamed.left) << " bytes still in use after deleting the tree" << endl; passed = false; }
+    }
+
+    if (passed) { cout << "memory: OK" << endl; }
+    return passed;
+}
+
+
+
+
+
+/***** ENTRY POINT *****/
+int main(int argc, char** argv) {
+    std::string directory = argc >= 2 ? argv[1] : "bin/stream";
+    mkdir(directory.c_str(), 0755);
+    std::string path = directory + "/stream.adl";
+
+    // Run them all, even if one fails
+    try {
+        bool passed = test_keep(path, 100);
+        passed = test_release(path, 100) && passed;
+        passed = test_memory(path, 1000) && passed;
+        return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (Exceptions::ExceptionHandler& e) {
+        return EXIT_FAILURE;
+    }
+}